@@ -0,0 +1,226 @@
+/*****************************************************************************
+The MIT License(MIT)
+
+Copyright(c) 2016 Amr Esam
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*********************************************************************************/
+#include "../boxyto/memory/LinearAllocator.h"
+#include "../boxyto/memory/PoolNodeAllocator.h"
+#include "../boxyto/algorithms/Parallel.h"
+#include "../boxyto/algorithms/RadixSort.h"
+#include "../boxyto/containers/StaticSearchIndex.h"
+#include "../boxyto/containers/UnrolledList.h"
+#include "../boxyto/containers/List.h"
+#include "../boxyto/algorithms/Find.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using namespace Everest;
+
+// Keeps benchmark results alive so the measured loops are not optimized away
+static volatile uint64 sink;
+
+// Run a function repeat times and return the best time in milliseconds
+//
+// @param: repeat - Count of runs
+// @param: setup - Called before each run, not measured
+// @param: function - Measured function
+template<class Setup, class Function>
+static double Measure(int repeat, Setup setup, Function function)
+{
+	double best = 1e30;
+	for (int i = 0; i < repeat; i++)
+	{
+		setup();
+		auto start = std::chrono::steady_clock::now();
+		function();
+		std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+		best = std::min(best, elapsed.count());
+	}
+	return best;
+}
+
+// Print a benchmark line with the baseline & the measured time
+static void Report(const char* name, const char* baselineName, double baseline, double measured)
+{
+	std::printf("%-40s %10.3f ms  %-20s %10.3f ms  %5.2fx\n", name, measured, baselineName, baseline, baseline / measured);
+}
+
+// FindIndex against the scalar loop on 4K ints
+static void BenchFind()
+{
+	std::vector<int> values(4096);
+	for (size_t i = 0; i < values.size(); i++)
+		values[i] = (int)i;
+
+	const int lookups = 20000;
+	auto none = [] {};
+	double scalar = Measure(5, none, [&]
+	{
+		uint64 sum = 0;
+		for (int i = 0; i < lookups; i++)
+			sum += ScalarFind(values.data(), values.size(), (i * 7919) & 4095);
+		sink = sum;
+	});
+	double simd = Measure(5, none, [&]
+	{
+		uint64 sum = 0;
+		for (int i = 0; i < lookups; i++)
+			sum += FindIndex(values.data(), values.size(), (i * 7919) & 4095);
+		sink = sum;
+	});
+	Report("FindIndex 4K ints x 20K", "ScalarFind", scalar, simd);
+}
+
+// RadixSort against std::sort on 10M 64-bit timestamps
+static void BenchRadixSort()
+{
+	std::mt19937_64 rng(1);
+	std::vector<uint64> source(10000000), values;
+	for (uint64& value : source)
+		value = 1700000000000000ull + rng() % (1ull << 40);
+
+	StaticSegment scratch((uint32)(source.size() * sizeof(uint64) * 2 / OSMemory::GetPageSize() + 2));
+	auto copy = [&] { values = source; };
+	double standard = Measure(3, copy, [&] { std::sort(values.begin(), values.end()); });
+	double radix = Measure(3, copy, [&] { RadixSort(values.data(), values.size(), scratch); });
+	Report("RadixSort 10M u64", "std::sort", standard, radix);
+}
+
+// ParallelSort against Sort on 10M uint32
+static void BenchParallelSort()
+{
+	std::mt19937 rng(2);
+	std::vector<uint32> source(10000000), values;
+	for (uint32& value : source)
+		value = rng();
+
+	auto copy = [&] { values = source; };
+	double serial = Measure(3, copy, [&] { Sort(values.data(), values.data() + values.size()); });
+	double parallel = Measure(3, copy, [&] { ParallelSort(values.data(), values.data() + values.size()); });
+	Report("ParallelSort 10M u32", "Sort", serial, parallel);
+}
+
+// StaticSearchIndex against std::lower_bound, 4M lookups in 4M keys
+static void BenchStaticSearchIndex()
+{
+	auto segment = std::make_shared<DynamicSegment>(64);
+	std::mt19937 rng(3);
+
+	std::vector<uint32> keys(4 * 1024 * 1024), lookups(keys.size());
+	for (uint32& key : keys)
+		key = rng();
+	for (uint32& lookup : lookups)
+		lookup = rng();
+	std::sort(keys.begin(), keys.end());
+
+	Array<uint32, LinearAllocator<uint32>> sorted(LinearAllocator<uint32>(segment, 16));
+	sorted.Append(keys.data(), (uint32)keys.size());
+	StaticSearchIndex<uint32> index(sorted, segment);
+
+	auto none = [] {};
+	double binary = Measure(3, none, [&]
+	{
+		uint64 sum = 0;
+		for (uint32 lookup : lookups)
+			sum += std::lower_bound(keys.begin(), keys.end(), lookup) - keys.begin();
+		sink = sum;
+	});
+	double eytzinger = Measure(3, none, [&]
+	{
+		uint64 sum = 0;
+		for (uint32 lookup : lookups)
+			sum += index.LowerBound(lookup);
+		sink = sum;
+	});
+	Report("StaticSearchIndex 4M keys x 4M", "std::lower_bound", binary, eytzinger);
+}
+
+// UnrolledList against DoubleLinkedList, iterating 1M ints
+// DoubleLinkedList Sort of 1M ints against std::sort of a copy
+// [user-050] DoubleLinkedList Sort of 1M ints against std::sort of a copy
+static void BenchLists()
+{
+	// A pool grows in place, so each list gets its own segment
+	auto listSegment = std::make_shared<DynamicSegment>(64);
+	auto unrolledSegment = std::make_shared<DynamicSegment>(64);
+	std::mt19937 rng(4);
+	const int count = 1000000;
+
+	DoubleLinkedList<int, PoolNodeAllocator<int>> list(PoolNodeAllocator<int>(listSegment, 1024));
+	UnrolledList<int, 32> unrolled(PoolNodeAllocator<int>(unrolledSegment, 1024));
+	for (int i = 0; i < count; i++)
+	{
+		int value = (int)rng();
+		list.Add(value);
+		unrolled.Add(value);
+	}
+
+	if (list.Size() != count || unrolled.Size() != count)
+	{
+		std::printf("List benchmarks skipped, out of memory\n");
+		return;
+	}
+
+	auto none = [] {};
+	double linked = Measure(5, none, [&]
+	{
+		uint64 sum = 0;
+		for (auto it = list.Begin(); it != list.End(); ++it)
+			sum += *it;
+		sink = sum;
+	});
+	double blocks = Measure(5, none, [&]
+	{
+		uint64 sum = 0;
+		for (auto it = unrolled.Begin(); it != unrolled.End(); ++it)
+			sum += *it;
+		sink = sum;
+	});
+	Report("UnrolledList<int, 32> iterate 1M", "DoubleLinkedList", linked, blocks);
+
+	std::vector<int> values;
+	double standard = Measure(1, none, [&]
+	{
+		values.clear();
+		for (auto it = list.Begin(); it != list.End(); ++it)
+			values.push_back(*it);
+		std::sort(values.begin(), values.end());
+	});
+	double sorted = Measure(1, none, [&] { list.Sort(); });
+	Report("DoubleLinkedList::Sort 1M", "copy + std::sort", standard, sorted);
+}
+
+int main()
+{
+	Everest::OSMemory::Init(2048ull * 1024 * 1024);
+
+	BenchFind();
+	BenchRadixSort();
+	BenchParallelSort();
+	BenchStaticSearchIndex();
+	BenchLists();
+	return 0;
+}
@@ -0,0 +1,261 @@
+/*****************************************************************************
+The MIT License(MIT)
+
+Copyright(c) 2016 Amr Esam
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*********************************************************************************/
+#include "TestCase.h"
+
+#include <malloc.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+// Test cases of libboxytomalloc.so, this program is run with the library preloaded
+//
+// Usage: LD_PRELOAD=../boxyto/libboxytomalloc.so interpose_tests [filter]
+
+// Fill a block with a byte pattern of its seed
+static void Fill(void* ptr, size_t size, unsigned seed)
+{
+	unsigned char* bytes = (unsigned char*)ptr;
+	for (size_t i = 0; i < size; i++)
+		bytes[i] = (unsigned char)(seed + i * 7);
+}
+
+// Return true if a block still holds the pattern written by Fill
+static bool Holds(const void* ptr, size_t size, unsigned seed)
+{
+	const unsigned char* bytes = (const unsigned char*)ptr;
+	for (size_t i = 0; i < size; i++)
+		if (bytes[i] != (unsigned char)(seed + i * 7))
+			return false;
+	return true;
+}
+
+TEST_CASE(MallocServesAllSizes)
+{
+	// Small classes, power of 2 classes & large segments
+	std::vector<void*> blocks;
+	std::vector<size_t> sizes;
+	for (size_t size = 1; size <= (size_t)8 << 20; size = size * 3 / 2 + 1)
+	{
+		void* ptr = malloc(size);
+		CHECK(ptr != nullptr);
+		if (!ptr)
+			continue;
+
+		CHECK((uintptr_t)ptr % 16 == 0);
+		CHECK(malloc_usable_size(ptr) >= size);
+		Fill(ptr, size, (unsigned)size);
+		blocks.push_back(ptr);
+		sizes.push_back(size);
+	}
+
+	for (size_t i = 0; i < blocks.size(); i++)
+	{
+		CHECK(Holds(blocks[i], sizes[i], (unsigned)sizes[i]));
+		free(blocks[i]);
+	}
+
+	void* zeroed = calloc(1000, 8);
+	CHECK(zeroed && malloc_usable_size(zeroed) >= 8000);
+	bool zero = true;
+	for (size_t i = 0; zeroed && i < 8000; i++)
+		zero = zero && ((unsigned char*)zeroed)[i] == 0;
+	CHECK(zero);
+	free(zeroed);
+}
+
+TEST_CASE(ReallocKeepsContents)
+{
+	size_t size = 10;
+	void* ptr = malloc(size);
+	Fill(ptr, size, 1);
+
+	// Grow through classes into large segments, then shrink back
+	bool kept = true;
+	for (int step = 0; step < 40; step++)
+	{
+		size_t next = step < 20 ? size * 2 : size / 2 + 1;
+		void* result = realloc(ptr, next);
+		CHECK(result != nullptr);
+		if (!result)
+			break;
+
+		kept = kept && Holds(result, next < size ? next : size, 1);
+		Fill(result, next, 1);
+		ptr = result;
+		size = next;
+	}
+	CHECK(kept);
+	free(ptr);
+}
+
+TEST_CASE(AlignedAllocations)
+{
+	// Alignments above the page size are served by libc
+	for (size_t alignment = 16; alignment <= ((size_t)1 << 23); alignment <<= 1)
+	{
+		void* ptr = nullptr;
+		CHECK(posix_memalign(&ptr, alignment, 100) == 0);
+		CHECK(ptr && (uintptr_t)ptr % alignment == 0);
+		if (ptr)
+			Fill(ptr, 100, 3);
+		free(ptr);
+
+		ptr = aligned_alloc(alignment, alignment * 2);
+		CHECK(ptr && (uintptr_t)ptr % alignment == 0);
+		free(ptr);
+	}
+
+	struct alignas(64) Line { char bytes[64]; };
+	Line* lines = new Line[100];
+	CHECK((uintptr_t)lines % 64 == 0);
+	delete[] lines;
+}
+
+TEST_CASE(BlocksFreedByOtherThreads)
+{
+	const int THREADS = 8, BLOCKS = 20000;
+	std::vector<std::vector<void*>> blocks(THREADS);
+
+	// Each thread allocates, the next thread frees
+	std::vector<std::thread> threads;
+	for (int t = 0; t < THREADS; t++)
+		threads.emplace_back([&blocks, t]()
+		{
+			for (int i = 0; i < BLOCKS; i++)
+			{
+				size_t size = 1 + (i * 37 + t) % 2000;
+				void* ptr = malloc(size);
+				if (ptr)
+					Fill(ptr, size, (unsigned)i);
+				blocks[t].push_back(ptr);
+			}
+		});
+	for (std::thread& thread : threads)
+		thread.join();
+	threads.clear();
+
+	std::atomic<int> broken(0);
+	for (int t = 0; t < THREADS; t++)
+		threads.emplace_back([&blocks, &broken, t]()
+		{
+			std::vector<void*>& own = blocks[(t + 1) % THREADS];
+			for (int i = 0; i < BLOCKS; i++)
+			{
+				size_t size = 1 + (i * 37 + (t + 1) % THREADS) % 2000;
+				if (!own[i] || !Holds(own[i], size, (unsigned)i))
+					++broken;
+				free(own[i]);
+			}
+		});
+	for (std::thread& thread : threads)
+		thread.join();
+
+	CHECK(broken == 0);
+}
+
+TEST_CASE(ExhaustedArenaFallsBackToLibc)
+{
+	// 1.5 GiB is past the default 1 GiB arena
+	const size_t SIZE = (size_t)32 << 20;
+	std::vector<void*> blocks;
+	for (int i = 0; i < 48; i++)
+	{
+		void* ptr = malloc(SIZE);
+		CHECK(ptr != nullptr);
+		if (!ptr)
+			continue;
+
+		((unsigned char*)ptr)[0] = (unsigned char)i;
+		((unsigned char*)ptr)[SIZE - 1] = (unsigned char)i;
+		CHECK(malloc_usable_size(ptr) >= SIZE);
+		blocks.push_back(ptr);
+	}
+
+	// Small blocks still work while the arena is full
+	void* small = malloc(100);
+	CHECK(small != nullptr);
+	if (small)
+		Fill(small, 100, 5);
+	small = realloc(small, 5000);
+	CHECK(small && Holds(small, 100, 5));
+	free(small);
+
+	bool kept = true;
+	for (size_t i = 0; i < blocks.size(); i++)
+	{
+		unsigned char* bytes = (unsigned char*)blocks[i];
+		kept = kept && bytes[0] == (unsigned char)i && bytes[SIZE - 1] == (unsigned char)i;
+		free(blocks[i]);
+	}
+	CHECK(kept);
+}
+
+TEST_CASE(HeapsOfManyFinishedThreads)
+{
+	// More threads than the orphans finish at once, the extra heaps are merged
+	const int THREADS = 300;
+	for (int round = 0; round < 2; round++)
+	{
+		std::atomic<int> started(0), broken(0);
+		std::vector<std::thread> threads;
+		for (int t = 0; t < THREADS; t++)
+			threads.emplace_back([&started, &broken, t]()
+			{
+				void* blocks[16];
+				for (int i = 0; i < 16; i++)
+				{
+					blocks[i] = malloc(1 + (i * 131 + t) % 2000);
+					if (blocks[i])
+						Fill(blocks[i], 1, (unsigned)t);
+				}
+
+				// Keep all threads alive until every thread allocated
+				++started;
+				while (started < THREADS)
+					std::this_thread::yield();
+
+				for (int i = 0; i < 16; i++)
+				{
+					if (!blocks[i] || !Holds(blocks[i], 1, (unsigned)t))
+						++broken;
+					if (i % 2)
+						free(blocks[i]);
+				}
+			});
+		for (std::thread& thread : threads)
+			thread.join();
+
+		CHECK(broken == 0);
+	}
+}
+
+// Run all tests, or tests with names containing the first argument
+int main(int argc, char** argv)
+{
+	return TestCase::RunAll(argc > 1 ? argv[1] : nullptr) ? 1 : 0;
+}
@@ -0,0 +1,307 @@
+/*****************************************************************************
+The MIT License(MIT)
+
+Copyright(c) 2016 Amr Esam
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*********************************************************************************/
+#include "TestCase.h"
+#include "../boxyto/memory/LinearAllocator.h"
+#include "../boxyto/algorithms/Parallel.h"
+#include "../boxyto/algorithms/RadixSort.h"
+#include "../boxyto/containers/ArrayView.h"
+#include "../boxyto/algorithms/Find.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace Everest;
+
+TEST_CASE(ThreadPoolRunsNestedGroups)
+{
+	ThreadPool pool(3);
+	std::atomic<int> count(0);
+
+	// Each task forks & waits on its own tasks, waiting threads run queued tasks so nothing deadlocks
+	TaskGroup group;
+	for (int i = 0; i < 16; i++)
+		pool.Run(group, [&]()
+		{
+			TaskGroup nested;
+			for (int j = 0; j < 16; j++)
+				pool.Run(nested, [&]() { count++; });
+			pool.Wait(nested);
+			CHECK(nested.Pending() == 0);
+		});
+	pool.Wait(group);
+
+	CHECK(count == 256);
+	CHECK(group.Pending() == 0);
+	CHECK(pool.GetThreadCount() == 4);
+}
+
+TEST_CASE(SortMatchesStdSort)
+{
+	std::mt19937 rng(1);
+
+	// Small sizes run the insertion sort only, larger ones go through the partitions
+	for (int n = 0; n < 200; n++)
+	{
+		std::vector<int> values(n);
+		for (int& value : values)
+			value = rng() % 10;
+
+		std::vector<int> expected = values;
+		Sort(values.data(), values.data() + n);
+		std::sort(expected.begin(), expected.end());
+		CHECK(values == expected);
+	}
+
+	// Patterns that make a naive quick sort quadratic
+	std::vector<int> values(100000);
+	for (size_t i = 0; i < values.size(); i++)
+		values[i] = (int)i;
+	Sort(values.data(), values.data() + values.size(), Greater<int>());
+	CHECK(std::is_sorted(values.rbegin(), values.rend()));
+
+	std::fill(values.begin(), values.end(), 7);
+	Sort(values.data(), values.data() + values.size());
+	CHECK(std::count(values.begin(), values.end(), 7) == (long)values.size());
+
+	for (size_t i = 0; i < values.size(); i++)
+		values[i] = (int)(i % 2 ? i : values.size() - i);
+	Sort(values.data(), values.data() + values.size());
+	CHECK(std::is_sorted(values.begin(), values.end()));
+}
+
+TEST_CASE(ParallelSortMatchesStdSort)
+{
+	ThreadPool pool(4);
+	std::mt19937 rng(2);
+
+	for (size_t n : { 0, 1, 1000, 400000 })
+	{
+		std::vector<uint32> values(n);
+		for (uint32& value : values)
+			value = rng();
+
+		std::vector<uint32> expected = values;
+		ParallelSort(values.data(), values.data() + n, Less<uint32>(), pool);
+		std::sort(expected.begin(), expected.end());
+		CHECK(values == expected);
+	}
+
+	// Non trivial elements are moved between partitions
+	std::vector<std::string> strings;
+	for (int i = 0; i < 100000; i++)
+		strings.push_back(std::to_string(rng()));
+
+	std::vector<std::string> expected = strings;
+	ParallelSort(strings.data(), strings.data() + strings.size(), Greater<std::string>(), pool);
+	std::sort(expected.begin(), expected.end(), Greater<std::string>());
+	CHECK(strings == expected);
+}
+
+TEST_CASE(ParallelReduceAndTransform)
+{
+	ThreadPool pool(4);
+
+	const size_t count = 1000003;
+	std::vector<double> values(count);
+	for (size_t i = 0; i < count; i++)
+		values[i] = (double)i;
+
+	double sum = ParallelReduce((const double*)values.data(), values.data() + count, 0.0, [](double a, double b) { return a + b; }, pool);
+	CHECK(sum == (double)count * (count - 1) / 2);
+
+	ParallelTransform((const double*)values.data(), values.data() + count, values.data(), [](double x) { return x * 2; }, pool);
+	CHECK(values[0] == 0 && values[count - 1] == 2.0 * (count - 1));
+
+	// Array overloads
+	auto segment = std::make_shared<DynamicSegment>(8);
+	Array<int, LinearAllocator<int>> array(LinearAllocator<int>(segment, 16));
+	for (int i = 0; i < 100000; i++)
+		array.Add((i * 7919) % 100000);
+
+	CHECK(ParallelReduce(array, 0, [](int a, int b) { return a > b ? a : b; }) == 99999);
+
+	ParallelSort(array.Begin(), array.End(), Greater<int>());
+	CHECK(array[0] == 99999 && array[array.Size() - 1] == 0);
+}
+
+TEST_CASE(RadixSortMatchesStdSort)
+{
+	StaticSegment scratch(64);
+	std::mt19937_64 rng(3);
+
+	{
+		std::vector<int> values(100001);
+		for (int& value : values)
+			value = (int)rng();
+
+		std::vector<int> expected = values;
+		CHECK(RadixSort(values.data(), values.size(), scratch));
+		std::sort(expected.begin(), expected.end());
+		CHECK(values == expected);
+	}
+
+	{
+		std::vector<short> values(1000);
+		for (short& value : values)
+			value = (short)rng();
+
+		std::vector<short> expected = values;
+		RadixSort(values.data(), values.size(), scratch);
+		std::sort(expected.begin(), expected.end());
+		CHECK(values == expected);
+	}
+
+	{
+		std::vector<long long> values(100000);
+		for (long long& value : values)
+			value = (long long)rng();
+
+		std::vector<long long> expected = values;
+		RadixSort(values.data(), values.size(), scratch);
+		std::sort(expected.begin(), expected.end());
+		CHECK(values == expected);
+	}
+
+	// Signed zeros & infinities keep their IEEE order
+	{
+		std::vector<float> values(100000);
+		for (float& value : values)
+			value = (float)((double)(int64_t)rng() / 1e15);
+		values[5] = -0.0f;
+		values[6] = 0.0f;
+		values[7] = INFINITY;
+		values[8] = -INFINITY;
+
+		std::vector<float> expected = values;
+		RadixSort(values.data(), values.size(), scratch);
+		std::stable_sort(expected.begin(), expected.end());
+		CHECK(std::equal(values.begin(), values.end(), expected.begin()));
+	}
+
+	{
+		std::vector<double> values(100000);
+		for (double& value : values)
+			value = (double)(int64_t)rng() / 1e10;
+
+		std::vector<double> expected = values;
+		RadixSort(values.data(), values.size(), scratch);
+		std::sort(expected.begin(), expected.end());
+		CHECK(values == expected);
+	}
+}
+
+TEST_CASE(RadixSortPairsIsStable)
+{
+	StaticSegment scratch(64);
+	std::mt19937_64 rng(4);
+
+	// Few distinct keys, the second value is the original index
+	const uint32 count = 200000;
+	std::vector<Pair<uint64, uint32>> values;
+	for (uint32 i = 0; i < count; i++)
+		values.push_back(Pair<uint64, uint32>(1700000000000ull + rng() % 5000, i));
+
+	CHECK(RadixSort(values.data(), count, scratch));
+
+	bool stable = true;
+	for (uint32 i = 1; i < count; i++)
+		if (values[i - 1]._first > values[i]._first
+			|| (values[i - 1]._first == values[i]._first && values[i - 1]._second > values[i]._second))
+			stable = false;
+	CHECK(stable);
+
+	// Scratch too small for the buffer
+	StaticSegment tiny(1);
+	std::vector<uint64> big(1 << 20);
+	CHECK(!RadixSort(big.data(), big.size(), tiny));
+}
+
+TEST_CASE(AlgorithmsOnArrayViews)
+{
+	ThreadPool pool(4);
+	auto segment = std::make_shared<DynamicSegment>(8);
+	StaticSegment scratch(8);
+
+	Array<int, LinearAllocator<int>> array(LinearAllocator<int>(segment, 16));
+	for (int i = 0; i < 100; i++)
+		array.Add(99 - i);
+
+	// Each algorithm only touches its slice
+	ArrayView<int> view(array);
+	Sort(view.Slice(10, 20));
+	CHECK(array[9] == 90 && array[10] == 70 && array[29] == 89 && array[30] == 69);
+
+	CHECK(RadixSort(view.Slice(0, 10), scratch));
+	CHECK(array[0] == 90 && array[9] == 99 && array[10] == 70);
+
+	ParallelSort(view.Slice(50), Less<int>(), pool);
+	CHECK(array[49] == 50 && array[50] == 0 && array[99] == 49);
+
+	ArrayView<const int> tail(array, 90, 10);
+	CHECK(ParallelReduce(tail, 0, [](int a, int b) { return a + b; }, pool) == 40 + 41 + 42 + 43 + 44 + 45 + 46 + 47 + 48 + 49);
+
+	ParallelTransform(view.Slice(95), [](int x) { return x * 2; }, pool);
+	CHECK(array[94] == 44 && array[95] == 90 && array[99] == 98);
+}
+
+// Check FindIndex & FindLastIndex against the scalar loops, for every length up to a few vectors
+template < class T, class Generator >
+static void CheckFind(Generator generate)
+{
+	std::mt19937 rng(5);
+	int mismatches = 0;
+	for (int count = 0; count < 300; count++)
+	{
+		std::vector<T> values(count);
+		for (T& value : values)
+			value = generate(rng() % 50);
+
+		T key = generate(rng() % 50);
+		if (FindIndex(values.data(), count, key) != ScalarFind(values.data(), count, key))
+			mismatches++;
+		if (FindLastIndex(values.data(), count, key) != ScalarFindLast(values.data(), count, key))
+			mismatches++;
+	}
+	CHECK(mismatches == 0);
+}
+
+TEST_CASE(FindMatchesScalarFind)
+{
+	static int targets[64];
+
+	CheckFind<char>([](int x) { return (char)x; });
+	CheckFind<unsigned short>([](int x) { return (unsigned short)(x * 1000); });
+	CheckFind<int>([](int x) { return x - 25; });
+	CheckFind<long long>([](int x) { return (long long)x << 33 | 7; });
+	CheckFind<int*>([](int x) { return targets + x % 64; });
+
+	// NaN never equals itself & -0 equals 0, as with operator ==
+	CheckFind<float>([](int x) { return x == 3 ? NAN : x == 4 ? -0.0f : (float)x; });
+	CheckFind<double>([](int x) { return x == 3 ? NAN : x == 4 ? 0.0 : x * 0.5; });
+}
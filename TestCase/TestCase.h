@@ -0,0 +1,117 @@
+/*****************************************************************************
+The MIT License(MIT)
+
+Copyright(c) 2016 Amr Esam
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*********************************************************************************/
+#pragma once
+
+#include <cstdio>
+#include <cstring>
+
+// Minimal test registry, every TEST_CASE registers itself before main runs,
+// CHECK records a failure and the test goes on so all failures of a run are printed
+namespace TestCase
+{
+	// A registered test function
+	struct Test
+	{
+		const char* name;
+		void(*function)();
+		Test* next;
+	};
+
+	// Head of the registered tests list
+	inline Test*& Head()
+	{
+		static Test* head = nullptr;
+		return head;
+	}
+
+	// Count of failed checks in the current run
+	inline int& Failures()
+	{
+		static int failures = 0;
+		return failures;
+	}
+
+	// Register a test at static initialization
+	struct Registrar
+	{
+		Registrar(Test& test)
+		{
+			// Keep registration order, tests of a file run in the order they are written
+			Test** last = &Head();
+			while (*last)
+				last = &(*last)->next;
+			*last = &test;
+		}
+	};
+
+	// Record a check result
+	//
+	// @param: passed - Check result
+	// @param: expression - The checked expression text
+	// @param: file - Source file of the check
+	// @param: line - Source line of the check
+	// @return: passed
+	inline bool Check(bool passed, const char* expression, const char* file, int line)
+	{
+		if (!passed)
+		{
+			Failures()++;
+			printf("    FAILED %s:%d: %s\n", file, line, expression);
+		}
+		return passed;
+	}
+
+	// Run all registered tests with names containing filter
+	//
+	// @param: filter - Part of the tests names to run, nullptr to run all
+	// @return: count of failed checks
+	inline int RunAll(const char* filter)
+	{
+		int count = 0;
+		for (Test* test = Head(); test; test = test->next)
+		{
+			if (filter && !strstr(test->name, filter))
+				continue;
+
+			int failures = Failures();
+			test->function();
+			printf("%s %s\n", Failures() == failures ? "[  OK  ]" : "[FAILED]", test->name);
+			count++;
+		}
+
+		printf("%d tests, %d failed checks\n", count, Failures());
+		return Failures();
+	}
+}
+
+// Define & register a test function
+#define TEST_CASE(name) \
+	static void name(); \
+	static TestCase::Test name##Test = { #name, name, nullptr }; \
+	static TestCase::Registrar name##Registrar(name##Test); \
+	static void name()
+
+// Check a condition, the test goes on if it fails
+#define CHECK(expression) TestCase::Check((expression) ? true : false, #expression, __FILE__, __LINE__)
@@ -0,0 +1,1272 @@
+/*****************************************************************************
+The MIT License(MIT)
+
+Copyright(c) 2016 Amr Esam
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*********************************************************************************/
+#include "TestCase.h"
+#include "../boxyto/memory/LinearAllocator.h"
+#include "../boxyto/memory/PoolNodeAllocator.h"
+#include "../boxyto/memory/SimpleNodeAllocator.h"
+#include "../boxyto/memory/IndexNodeAllocator.h"
+#include "../boxyto/containers/Array.h"
+#include "../boxyto/containers/ArrayView.h"
+#include "../boxyto/containers/BitArray.h"
+#include "../boxyto/containers/ChunkedArray.h"
+#include "../boxyto/containers/FlatMap.h"
+#include "../boxyto/containers/List.h"
+#include "../boxyto/containers/Map.h"
+#include "../boxyto/containers/Sets.h"
+#include "../boxyto/containers/SmallArray.h"
+#include "../boxyto/containers/SoaArray.h"
+#include "../boxyto/containers/StaticSearchIndex.h"
+#include "../boxyto/containers/UnrolledList.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <list>
+#include <map>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace Everest;
+
+TEST_CASE(ArrayAddFindCopy)
+{
+	auto segment = std::make_shared<DynamicSegment>(8);
+
+	Array<int, LinearAllocator<int>> array(LinearAllocator<int>(segment, 16));
+	for (int i = 0; i < 1000; i++)
+		CHECK(array.Add(i % 300) == i);
+
+	CHECK(array.Size() == 1000);
+	CHECK(array.Find(299) == 299);
+	CHECK(array.Find(299, 300) == 599);
+	CHECK(array.FindLast(5) == 905);
+	CHECK(array.Find(300) == INDEX_NONE);
+	CHECK(array.Find(5, 1000) == INDEX_NONE && array.Find(5, 5000) == INDEX_NONE);
+	CHECK(array.Contains(0) && !array.Contains(-1));
+
+	Array<int, LinearAllocator<int>> copy(array);
+	bool same = copy.Size() == array.Size();
+	for (uint32 i = 0; i < copy.Size() && same; i++)
+		same = copy[i] == (int)(i % 300);
+	CHECK(same);
+}
+
+TEST_CASE(ArrayMatchesVector)
+{
+	auto segment = std::make_shared<DynamicSegment>(8);
+	std::mt19937 rng(1);
+
+	Array<int, LinearAllocator<int>> array(LinearAllocator<int>(segment, 16));
+	std::vector<int> expected;
+
+	for (int step = 0; step < 2000; step++)
+	{
+		int value = rng() % 100;
+		int index = expected.empty() ? 0 : rng() % expected.size();
+
+		switch (rng() % 4)
+		{
+		case 0:
+			array.Add(value);
+			expected.push_back(value);
+			break;
+
+		case 1:
+			array.Insert(value, index);
+			expected.insert(expected.begin() + index, value);
+			break;
+
+		case 2:
+		{
+			// Remove up to 3 elements, the following elements shift back by the count
+			if (expected.empty())
+				break;
+			int count = std::min<int>(1 + rng() % 3, (int)expected.size() - index);
+			array.Remove(index, count);
+			expected.erase(expected.begin() + index, expected.begin() + index + count);
+			break;
+		}
+
+		default:
+		{
+			auto found = std::find(expected.begin(), expected.end(), value);
+			int32 expectedIndex = found == expected.end() ? INDEX_NONE : (int32)(found - expected.begin());
+			CHECK(array.Find(value) == expectedIndex);
+			CHECK(array.Contains(value) == (found != expected.end()));
+			break;
+		}
+		}
+	}
+
+	CHECK(array.Size() == expected.size());
+	CHECK(std::equal(expected.begin(), expected.end(), array.Data()));
+
+	Array<int, LinearAllocator<int>> copy(array);
+	CHECK(copy.Size() == array.Size() && std::equal(expected.begin(), expected.end(), copy.Data()));
+}
+
+// Allocate count elements one at a time, return how many times the capacity changed
+template <class AllocatorType>
+static uint32 CountGrowths(AllocatorType& allocator, uint32 count)
+{
+	uint32 growths = 0;
+	for (uint32 i = 0; i < count; i++)
+	{
+		uint32 capacity = allocator.GetCapacity();
+		int* data = allocator.Allocate().Get();
+		data[i] = (int)i;
+		if (allocator.GetCapacity() != capacity)
+			++growths;
+	}
+	return growths;
+}
+
+TEST_CASE(ArrayAppendsRanges)
+{
+	auto segment = std::make_shared<DynamicSegment>(8);
+
+	std::vector<int> values(1000);
+	for (int i = 0; i < 1000; i++)
+		values[i] = i * 3;
+	std::list<int> linked(values.begin(), values.begin() + 10);
+
+	Array<int, LinearAllocator<int>> array(LinearAllocator<int>(segment, 4));
+	array.Add(-1);
+	CHECK(array.Append(values.data(), 500) == 1);
+	CHECK(array.Append(values.data() + 500, values.data() + 1000) == 501);
+	CHECK(array.Append(linked.begin(), linked.end()) == 1001);
+	CHECK(array.Append(values.data(), 0) == INDEX_NONE && array.Append(linked.end(), linked.end()) == INDEX_NONE);
+
+	CHECK(array.Size() == 1011 && array[0] == -1 && array[1000] == 2997 && array[1010] == 27);
+	CHECK(std::equal(values.begin(), values.end(), array.Data() + 1));
+
+	Array<int, LinearAllocator<int>> other(LinearAllocator<int>(segment, 4));
+	CHECK(other.Append(array.Begin(), array.End()) == 0);
+	CHECK(other.Size() == 1011 && std::equal(array.Data(), array.Data() + 1011, other.Data()));
+
+	// Non trivial elements are copy constructed
+	std::vector<std::string> strings;
+	for (int i = 0; i < 100; i++)
+		strings.push_back(std::to_string(i) + " is long enough to be heap allocated");
+
+	Array<std::string, LinearAllocator<std::string>> copies(LinearAllocator<std::string>(segment, 4));
+	CHECK(copies.Append(strings.data(), 50) == 0);
+	CHECK(copies.Append(strings.begin() + 50, strings.end()) == 50);
+	CHECK(copies.Size() == 100 && std::equal(strings.begin(), strings.end(), copies.Data()));
+
+	// Input only ranges are read once, element by element
+	std::istringstream stream("4 8 15 16 23 42");
+	Array<int, LinearAllocator<int>> numbers(LinearAllocator<int>(segment, 2));
+	CHECK(numbers.Append(std::istream_iterator<int>(stream), std::istream_iterator<int>()) == 0);
+	CHECK(numbers.Size() == 6 && numbers[0] == 4 && numbers[5] == 42);
+	CHECK(numbers.Append(std::istream_iterator<int>(stream), std::istream_iterator<int>()) == INDEX_NONE);
+
+	// Containers iterators of other element types are counted by a pass
+	Array<int64, LinearAllocator<int64>> wide(LinearAllocator<int64>(segment, 2));
+	CHECK(wide.Append(numbers.Begin(), numbers.End()) == 0 && wide.Size() == 6 && wide[3] == 16);
+
+	// Elements of the array itself are copied before the array grows
+	uint32 size = numbers.Size();
+	while (numbers.Size() < numbers.GetAllocator().GetCapacity())
+		numbers.Add(0);
+	CHECK(numbers.Append(numbers.Data(), 4) == (int32)numbers.Size() - 4);
+	CHECK(numbers.Append(numbers.Data() + 1, numbers.Data() + 3) == (int32)numbers.Size() - 2);
+	CHECK(numbers[numbers.Size() - 6] == 4 && numbers[numbers.Size() - 3] == 16);
+	CHECK(numbers[numbers.Size() - 2] == 8 && numbers[numbers.Size() - 1] == 15 && numbers[size - 1] == 42);
+}
+
+TEST_CASE(ArrayViewSlicesWithoutCopying)
+{
+	auto segment = std::make_shared<DynamicSegment>(8);
+
+	Array<int, LinearAllocator<int>> array(LinearAllocator<int>(segment, 16));
+	for (int i = 0; i < 100; i++)
+		array.Add(i);
+
+	ArrayView<int> view(array);
+	ArrayView<int> middle = view.Slice(10, 20);
+	ArrayView<const int> tail(array, 90, 50);
+
+	CHECK(view.Size() == 100 && view.Data() == array.Data());
+	CHECK(middle.Size() == 20 && middle.Data() == array.Data() + 10 && middle[0] == 10);
+	CHECK(tail.Size() == 10 && tail[9] == 99);
+	CHECK(view.Slice(100).Empty() && view.Slice(200, 5).Empty() && view.Slice(95).Size() == 5);
+
+	// Writes through a view change the array
+	middle[1] = -11;
+	CHECK(array[11] == -11);
+
+	CHECK(tail.Contains(95) && !tail.Contains(5));
+	CHECK(middle.IndexOf(-11) == 1 && middle.IndexOf(50) == INDEX_NONE);
+
+	int count = 0, sum = 0;
+	for (auto it = tail.cBegin(); it != tail.cEnd(); ++it, ++count)
+		sum += *it;
+	CHECK(count == 10 && sum == 945);
+
+	Array<int, LinearAllocator<int>> other(LinearAllocator<int>(segment, 2));
+	other.Add(-1);
+	other.Add(-2);
+	CHECK(other.Append(middle) == 2);
+	CHECK(other.Insert(tail, 1) == 1);
+	CHECK(other.Size() == 32 && other[0] == -1 && other[1] == 90 && other[10] == 99);
+	CHECK(other[11] == -2 && other[12] == 10 && other[13] == -11 && other[31] == 29);
+
+	// Views of the array itself are copied before the array grows,
+	// elements are relocated by memory copies, so elements are vectors not strings
+	typedef std::vector<int> Word;
+	Array<Word, LinearAllocator<Word>> words(LinearAllocator<Word>(segment, 4));
+	words.Add(Word(1, 'a'));
+	words.Add(Word(2, 'b'));
+	words.Add(Word(3, 'c'));
+	CHECK(words.Append(ArrayView<Word>(words)) == 3);
+	CHECK(words.Insert(ArrayView<const Word>(words, 1, 2), 5) == 5);
+	CHECK(words.Insert(ArrayView<Word>(words).Slice(0, 3), 0) == 0);
+
+	const char* expected = "abcabcabbcc";
+	bool same = words.Size() == 11;
+	for (uint32 i = 0; same && i < 11; i++)
+		same = words[i].back() == expected[i] && words[i].size() == (size_t)(expected[i] - 'a' + 1);
+	CHECK(same);
+}
+
+TEST_CASE(SetsOfArraysAndViews)
+{
+	auto segment = std::make_shared<DynamicSegment>(8);
+
+	typedef Array<int, LinearAllocator<int>> IntArray;
+	IntArray a(LinearAllocator<int>(segment, 8)), b(LinearAllocator<int>(segment, 8));
+	for (int i = 0; i < 10; i++)
+		a.Add(i);
+	for (int i = 5; i < 15; i++)
+		b.Add(i);
+
+	IntArray both = Intersection(a, b);
+	IntArray any = Union(a, ArrayView<const int>(b));
+	IntArray left = Differnce(a, ArrayView<int>(b).Slice(0, 3));
+
+	CHECK(both.Size() == 5 && both[0] == 5 && both[4] == 9);
+	CHECK(any.Size() == 15 && any[0] == 0 && any[14] == 14);
+	CHECK(left.Size() == 7 && left[4] == 4 && left[5] == 8 && left[6] == 9);
+	CHECK(Include(a, ArrayView<int>(a).Slice(2, 5)) && !Include(a, b));
+}
+
+TEST_CASE(LinearAllocatorGrowthPolicies)
+{
+	CHECK(GrowthHalf::Grow(16, 17) == 24 && GrowthHalf::Grow(1, 2) == 2);
+	CHECK(GrowthDouble::Grow(16, 17) == 32 && GrowthDouble::Grow(16, 100) == 100);
+	CHECK(GrowthDouble::Grow(0x80000000u, 0x80000001u) == 0x80000001u);
+	CHECK(GrowthFixed<16>::Grow(16, 17) == 32 && GrowthFixed<16>::Grow(0, 1) == 16);
+
+	auto segment = std::make_shared<DynamicSegment>(8);
+
+	LinearAllocator<int, GrowthHalf> half(segment, 16);
+	LinearAllocator<int, GrowthDouble> twice(segment, 16);
+	LinearAllocator<int, GrowthFixed<64>> fixed(segment, 16);
+	half.Init();
+	twice.Init();
+	fixed.Init();
+
+	// 16 -> 4096 elements, geometric growth reallocates log(n) times, fixed chunks n/CHUNK times
+	CHECK(CountGrowths(twice, 4096) == 8 && twice.GetCapacity() == 4096);
+	CHECK(CountGrowths(half, 4096) <= 14 && half.GetCapacity() >= 4096);
+	CHECK(CountGrowths(fixed, 4096) == 64 && fixed.GetCapacity() == 4096);
+
+	bool same = true;
+	for (uint32 i = 0; i < 4096; i++)
+		same = same && half.Get().Get()[i] == (int)i && twice.Get().Get()[i] == (int)i && fixed.Get().Get()[i] == (int)i;
+	CHECK(same);
+
+	// Reserve gives exactly the requested capacity and never shrinks
+	twice.Reserve(10000);
+	CHECK(twice.GetCapacity() == 10000);
+	twice.Reserve(100);
+	CHECK(twice.GetCapacity() == 10000);
+
+	// Out of memory is reported, and leaves the allocator as it was
+	CHECK(!twice.Allocate(0x40000000) && !twice.Reserve(0x40000000));
+	CHECK(twice.GetCapacity() == 10000 && twice.Get().Get()[4095] == 4095);
+	CHECK(twice.Allocate(10000 - 4096) && twice.GetCapacity() == 10000);
+
+	Array<int, LinearAllocator<int, GrowthDouble>> array(LinearAllocator<int, GrowthDouble>(segment, 4));
+	for (int i = 0; i < 1000; i++)
+		array.Add(i);
+	CHECK(array.Size() == 1000 && array[999] == 999);
+
+	// Array reserves exactly, and keeps its elements when out of memory
+	uint32 capacity = array.Capacity();
+	CHECK(array.Reserve(100) && array.Capacity() == capacity + 100);
+	CHECK(array.GetAllocator().GetCapacity() >= capacity + 100);
+	CHECK(!array.Reserve(0x40000000) && array.Capacity() == capacity + 100);
+	CHECK(array.Add(1000) == 1000 && array[999] == 999);
+}
+
+TEST_CASE(SmallArraySpillsPastInlineCount)
+{
+	auto segment = std::make_shared<DynamicSegment>(8);
+
+	SmallArray<int, 8> array(segment);
+	for (int i = 0; i < 8; i++)
+		array.Add(i);
+	CHECK(array.IsInline() && array.Size() == 8);
+
+	// The 9th element spills all elements to the segment
+	for (int i = 8; i < 100; i++)
+		array.Add(i);
+	CHECK(!array.IsInline() && array.Size() == 100);
+
+	bool same = true;
+	for (uint32 i = 0; i < array.Size(); i++)
+		same = same && array[i] == (int)i;
+	CHECK(same);
+
+	array.Insert(-1, 3);
+	CHECK(array[2] == 2 && array[3] == -1 && array[4] == 3 && array.Size() == 101);
+
+	SmallArray<int, 8> copy(array);
+	CHECK(copy.Size() == 101 && copy[50] == 49 && copy[100] == 99);
+
+	// Copies of a small array stay inline
+	SmallArray<int, 8> small(segment);
+	small.Add(5);
+	small.Add(6);
+	SmallArray<int, 8> smallCopy(small);
+	CHECK(smallCopy.IsInline() && smallCopy.Size() == 2 && smallCopy[1] == 6);
+}
+
+TEST_CASE(SoaArrayKeepsAlignedColumns)
+{
+	struct Vector3 { float x, y, z; };
+	auto segment = std::make_shared<DynamicSegment>(8);
+
+	// Small initial capacity, so columns are relocated many times while growing
+	SoaArray<double, char, Vector3, std::string> array(segment, 2);
+	for (int i = 0; i < 1000; i++)
+		array.Add(i * 0.5, (char)('a' + i % 26), Vector3{ (float)i, 0, 0 }, std::to_string(i) + " is long enough to be heap allocated");
+
+	CHECK(array.Size() == 1000 && array.Capacity() >= 1000);
+	CHECK((UINTPTR)array.Column<0>() % 64 == 0 && (UINTPTR)array.Column<1>() % 64 == 0);
+	CHECK((UINTPTR)array.Column<2>() % 64 == 0 && (UINTPTR)array.Column<3>() % 64 == 0);
+
+	double sum = 0;
+	for (auto it = array.Begin<0>(); it != array.End<0>(); ++it)
+		sum += *it;
+	CHECK(sum == 0.5 * 999 * 1000 / 2);
+
+	bool same = true;
+	for (uint32 i = 0; i < array.Size(); i++)
+		same = same && array.Get<1>(i) == (char)('a' + i % 26) && array.Get<2>(i).x == (float)i
+			&& array.Get<3>(i) == std::to_string(i) + " is long enough to be heap allocated";
+	CHECK(same);
+
+	array.Remove(10, 5);
+	CHECK(array.Size() == 995 && array.Get<0>(10) == 7.5 && array.Get<3>(10).compare(0, 3, "15 ") == 0);
+
+	array.Swap(0, 1);
+	CHECK(array.Get<0>(0) == 0.5 && array.Get<3>(1).compare(0, 2, "0 ") == 0);
+
+	SoaArray<double, char, Vector3, std::string> copy(array);
+	CHECK(copy.Size() == 995 && copy.Get<0>(994) == 499.5 && copy.Get<3>(994) == array.Get<3>(994));
+
+	std::string moved = "moved";
+	copy.Add(1.0, 'z', Vector3{}, Everest::Move(moved));
+	CHECK(copy.Get<3>(995) == "moved" && copy.Get<1>(995) == 'z');
+
+	int32 index = array.AddDefault(3);
+	CHECK(index == 995 && array.Size() == 998 && array.Get<3>(997).empty() && array.Get<0>(996) == 0.0);
+
+	// Destroyed arrays free their columns block, so one page holds a big array at a time
+	auto page = std::make_shared<DynamicSegment>(1);
+	bool reserved = true;
+	for (int round = 0; round < 8; round++)
+	{
+		SoaArray<double, int64> big(page, 16);
+		reserved = reserved && big.Reserve(100000);
+	}
+	CHECK(reserved);
+}
+
+TEST_CASE(ChunkedArrayKeepsElementAddresses)
+{
+	auto segment = std::make_shared<DynamicSegment>(64);
+
+	ChunkedArray<int64, 8> array(segment);
+	array.Add(-5);
+	int64* first = &array[0];
+	int64* last = &array[255];
+	for (int64 i = 1; i < 100000; i++)
+		array.Add(i);
+
+	CHECK(array.Size() == 100000 && array.BlockCount() == (100000 + 255) / 256);
+	CHECK(first == &array[0] && &array[255] == last);
+
+	int64 sum = 0;
+	for (auto it = array.Begin(); it != array.End(); ++it)
+		sum += *it;
+	CHECK(sum == 99999LL * 100000 / 2 - 5);
+
+	ChunkedArray<int64, 8> copy(array);
+	CHECK(copy.Size() == 100000 && copy[99999] == 99999 && &copy[0] != first);
+
+	array.RemoveLast(3);
+	CHECK(array.Size() == 99997 && array.Top() == 99996);
+
+	// Blocks released by one array are reused by the next
+	ChunkedArray<std::vector<int>, 4> vectors(segment);
+	for (int i = 0; i < 100; i++)
+		vectors.Emplace(5, i);
+	CHECK(vectors[77].size() == 5 && vectors[77][4] == 77);
+
+	vectors.Release();
+	CHECK(vectors.BlockCount() == 0 && vectors.Size() == 0);
+	for (int i = 0; i < 100; i++)
+		vectors.Emplace(2, -i);
+	CHECK(vectors.Size() == 100 && vectors[99][1] == -99);
+}
+
+TEST_CASE(FlatMapInsertSortedMatchesStdMap)
+{
+	auto segment = std::make_shared<DynamicSegment>(8);
+	std::mt19937 rng(1);
+
+	typedef Pair<int, std::vector<int>> Element;
+	typedef LinearAllocator<Element> Allocator;
+	FlatMap<int, std::vector<int>, Allocator> map(Allocator(segment, 16));
+	std::map<int, std::vector<int>> expected;
+
+	for (int step = 0; step < 3000; step++)
+	{
+		int key = rng() % 500;
+		switch (rng() % 4)
+		{
+		case 0:
+			map.InsertUnique(Element(key, std::vector<int>(3, step)));
+			expected[key] = std::vector<int>(3, step);
+			break;
+
+		case 1:
+			CHECK(map.Remove(key) == (expected.erase(key) > 0));
+			break;
+
+		case 2:
+		{
+			const std::vector<int>* found = map.Find(key);
+			auto it = expected.find(key);
+			CHECK((found != nullptr) == (it != expected.end()));
+			if (found && it != expected.end())
+				CHECK(*found == it->second);
+			break;
+		}
+
+		default:
+		{
+			// Sorted batch with duplicate keys, the last of equal keys is kept
+			std::vector<int> keys(rng() % 40);
+			for (int& batchKey : keys)
+				batchKey = rng() % 500;
+			std::sort(keys.begin(), keys.end());
+
+			std::vector<Element> batch;
+			for (size_t i = 0; i < keys.size(); i++)
+			{
+				batch.push_back(Element(keys[i], std::vector<int>(2, step * 100 + (int)i)));
+				expected[keys[i]] = batch.back()._second;
+			}
+			map.InsertSorted(batch.data(), (uint32)batch.size());
+			break;
+		}
+		}
+	}
+
+	CHECK(map.Size() == expected.size());
+
+	int index = 0;
+	bool same = true;
+	for (auto& element : expected)
+	{
+		same = same && map[index]._first == element.first && map[index]._second == element.second;
+		index++;
+	}
+	CHECK(same);
+}
+
+TEST_CASE(FlatSetBounds)
+{
+	auto segment = std::make_shared<DynamicSegment>(8);
+
+	FlatSet<int, LinearAllocator<int>> set(LinearAllocator<int>(segment, 16));
+	int values[] = { 1, 3, 3, 5, 9 };
+	set.InsertSorted(values, 5);
+	set.Insert(3);
+	set.InsertUnique(4);
+
+	CHECK(set.Size() == 6);
+	CHECK(set.Contains(4) && !set.Contains(7));
+	CHECK(set.LowerBound(3) == 1);
+	CHECK(set.UpperBound(3) == 3);
+	CHECK(set.IndexOf(9) == 5);
+	CHECK(set.IndexOf(2) == INDEX_NONE);
+}
+
+TEST_CASE(StaticSearchIndexMatchesBinarySearch)
+{
+	auto segment = std::make_shared<DynamicSegment>(32);
+	std::mt19937 rng(2);
+
+	// Sizes around complete tree levels
+	for (int count : { 0, 1, 2, 3, 7, 8, 15, 16, 17, 100, 1000, 4095 })
+	{
+		std::vector<int> values(count);
+		for (int& value : values)
+			value = rng() % (count + 5);
+		std::sort(values.begin(), values.end());
+
+		Array<int, LinearAllocator<int>> array(LinearAllocator<int>(segment, 16));
+		for (int value : values)
+			array.Add(value);
+		StaticSearchIndex<int> index(array, segment);
+
+		int mismatches = 0;
+		for (int key = -2; key < count + 8; key++)
+		{
+			uint32 lower = (uint32)(std::lower_bound(values.begin(), values.end(), key) - values.begin());
+			uint32 upper = (uint32)(std::upper_bound(values.begin(), values.end(), key) - values.begin());
+			int32 found = (lower < values.size() && values[lower] == key) ? (int32)lower : INDEX_NONE;
+
+			if (index.LowerBound(key) != lower || index.UpperBound(key) != upper || index.IndexOf(key) != found)
+				mismatches++;
+		}
+		CHECK(mismatches == 0);
+	}
+}
+
+// Check a bit array against a vector of bools, bits, count & scans
+static bool SameBits(const BitArray& bits, const std::vector<bool>& expected)
+{
+	if (bits.Size() != expected.size())
+		return false;
+
+	uint64 count = 0;
+	for (size_t i = 0; i < expected.size(); i++)
+	{
+		if (bits.Test((uint32)i) != expected[i])
+			return false;
+		count += expected[i];
+	}
+
+	if (bits.Count() != count)
+		return false;
+
+	int32 set = bits.FindNextSet(0);
+	int32 clear = bits.FindNextClear(0);
+	for (size_t i = 0; i < expected.size(); i++)
+	{
+		if (expected[i])
+		{
+			if (set != (int32)i)
+				return false;
+			set = bits.FindNextSet((uint32)i + 1);
+		}
+		else
+		{
+			if (clear != (int32)i)
+				return false;
+			clear = bits.FindNextClear((uint32)i + 1);
+		}
+	}
+
+	return set == INDEX_NONE && clear == INDEX_NONE;
+}
+
+TEST_CASE(BitArrayMatchesVectorBool)
+{
+	auto segment = std::make_shared<DynamicSegment>(32);
+	std::mt19937 rng(3);
+
+	// Sizes around word & vector boundaries, the tail word bits must stay clear
+	for (uint32 count : { 0u, 1u, 63u, 64u, 65u, 127u, 128u, 129u, 300u, 1000u, 4099u })
+	{
+		BitArray a(count, false, segment), b(count, true, segment);
+		std::vector<bool> expectedA(count, false), expectedB(count, true);
+		for (uint32 i = 0; i < count; i++)
+		{
+			bool value = rng() & 1;
+			a.Set(i, value);
+			expectedA[i] = value;
+
+			if (rng() % 3 == 0)
+			{
+				b.Reset(i);
+				expectedB[i] = false;
+			}
+		}
+		CHECK(SameBits(a, expectedA));
+		CHECK(SameBits(b, expectedB));
+
+		BitArray c(a);
+		std::vector<bool> expected = expectedA;
+		CHECK(c.And(b));
+		for (uint32 i = 0; i < count; i++)
+			expected[i] = expected[i] && expectedB[i];
+		CHECK(SameBits(c, expected));
+
+		c = a;
+		expected = expectedA;
+		c.Or(b);
+		for (uint32 i = 0; i < count; i++)
+			expected[i] = expected[i] || expectedB[i];
+		CHECK(SameBits(c, expected));
+
+		c = a;
+		expected = expectedA;
+		c.Xor(b);
+		for (uint32 i = 0; i < count; i++)
+			expected[i] = expected[i] != expectedB[i];
+		CHECK(SameBits(c, expected));
+
+		c = a;
+		expected = expectedA;
+		c.AndNot(b);
+		for (uint32 i = 0; i < count; i++)
+			expected[i] = expected[i] && !expectedB[i];
+		CHECK(SameBits(c, expected));
+
+		c.FlipAll();
+		expected.flip();
+		CHECK(SameBits(c, expected));
+
+		c.Resize(count + 70, true);
+		expected.resize(count + 70, true);
+		CHECK(SameBits(c, expected));
+
+		c.Resize(count / 2);
+		expected.resize(count / 2);
+		CHECK(SameBits(c, expected));
+
+		// Different sizes are rejected
+		BitArray d(count + 1, false, segment);
+		CHECK(!a.And(d));
+	}
+}
+
+// Run random adds, pops & removes on list and std::list, then compare them
+template <class ListType>
+static void CheckListMatchesStdList(ListType& list, uint32 seed)
+{
+	std::mt19937 rng(seed);
+	std::list<int> expected;
+
+	for (int step = 0; step < 2000; step++)
+	{
+		int value = rng() % 100;
+
+		switch (rng() % 4)
+		{
+		case 0:
+			list.Add(value);
+			expected.push_back(value);
+			break;
+
+		case 1:
+			list.AddFront(value);
+			expected.push_front(value);
+			break;
+
+		case 2:
+			if (expected.empty())
+				break;
+			list.Pop();
+			expected.pop_back();
+			break;
+
+		default:
+		{
+			auto found = std::find(expected.begin(), expected.end(), value);
+			CHECK(list.Contains(value) == (found != expected.end()));
+			if (found != expected.end())
+			{
+				list.Remove(value);
+				expected.erase(found);
+			}
+			break;
+		}
+		}
+	}
+
+	CHECK(list.Size() == expected.size());
+	CHECK(std::equal(expected.begin(), expected.end(), list.Begin()));
+}
+
+TEST_CASE(DoubleLinkedListMatchesStdList)
+{
+	auto segment = std::make_shared<DynamicSegment>(8);
+
+	DoubleLinkedList<int, PoolNodeAllocator<int>> list(PoolNodeAllocator<int>(segment, 16));
+	CheckListMatchesStdList(list, 2);
+}
+
+TEST_CASE(UnrolledListMatchesStdList)
+{
+	auto segment = std::make_shared<DynamicSegment>(64);
+	std::mt19937 rng(4);
+
+	// Small nodes so inserts split & removals borrow or merge often
+	typedef std::vector<int> Element;
+	UnrolledList<Element, 8> list(PoolNodeAllocator<Element>(segment, 4096));
+	std::list<Element> expected;
+
+	for (int step = 0; step < 20000; step++)
+	{
+		Element value(1 + rng() % 3, step);
+		int position = expected.empty() ? 0 : rng() % expected.size();
+		auto it = list.Begin();
+		auto expectedIt = expected.begin();
+
+		switch (rng() % 6)
+		{
+		case 0:
+			list.Add(value);
+			expected.push_back(value);
+			break;
+
+		case 1:
+			list.AddFront(value);
+			expected.push_front(value);
+			break;
+
+		case 2:
+			if (expected.empty())
+				break;
+			std::advance(expectedIt, position);
+			for (int i = 0; i < position; i++)
+				++it;
+			list.Insert(value, it);
+			expected.insert(std::next(expectedIt), value);
+			break;
+
+		case 3:
+			if (expected.empty())
+				break;
+			std::advance(expectedIt, position);
+			for (int i = 0; i < position; i++)
+				++it;
+			list.Remove(it);
+			expected.erase(expectedIt);
+			break;
+
+		case 4:
+			if (expected.empty())
+				break;
+			CHECK(list.Top() == expected.back());
+			list.Pop();
+			expected.pop_back();
+			break;
+
+		default:
+			if (expected.empty())
+				break;
+			CHECK(list.Front() == expected.front());
+			list.Dequeue();
+			expected.pop_front();
+			break;
+		}
+
+		CHECK(list.Size() == expected.size());
+	}
+
+	// Forward & backward iteration see the same elements
+	CHECK(std::equal(expected.begin(), expected.end(), list.Begin()));
+
+	bool same = true;
+	auto it = list.End();
+	for (auto expectedIt = expected.rbegin(); expectedIt != expected.rend(); ++expectedIt)
+		same = same && *--it == *expectedIt;
+	CHECK(same && it == list.Begin());
+
+	// Nodes stay at least half full after removals
+	CHECK(list.NodeCount() <= (list.Size() + 3) / 4 + 1);
+}
+
+TEST_CASE(UnrolledListFindAndRemove)
+{
+	auto segment = std::make_shared<DynamicSegment>(8);
+
+	UnrolledList<int, 32> list(PoolNodeAllocator<int>(segment, 64));
+	for (int i = 0; i < 1000; i++)
+		list.Add(i % 500);
+
+	auto first = list.Find(77);
+	auto last = list.FindLast(77);
+	CHECK(first._first && *first._second == 77);
+	CHECK(last._first && last._second != first._second);
+
+	list.Remove(77);
+	CHECK(list.Contains(77));
+	list.Remove(77);
+	CHECK(!list.Contains(77));
+	CHECK(list.Size() == 998);
+
+	list.Clear();
+	CHECK(list.Size() == 0 && list.NodeCount() == 0 && list.Begin() == list.End());
+}
+
+// Element with a key to sort by & a value to check stability
+struct KeyValue
+{
+	int key;
+	int value;
+
+	bool operator==(const KeyValue& other) const
+	{
+		return key == other.key && value == other.value;
+	}
+};
+
+// Compare KeyValue by key only
+struct KeyLess
+{
+	bool operator()(const KeyValue& a, const KeyValue& b) const
+	{
+		return a.key < b.key;
+	}
+};
+
+typedef DoubleLinkedList<KeyValue, SimpleNodeAllocator<KeyValue>> KeyValueList;
+
+// Return list elements, checking the previous links walk the same elements back
+static std::vector<KeyValue> Elements(KeyValueList& list)
+{
+	std::vector<KeyValue> forward, backward;
+	for (auto it = list.Begin(); it != list.End(); ++it)
+		forward.push_back(*it);
+	for (auto it = list.rBegin(); it != list.rEnd(); ++it)
+		backward.push_back(*it);
+
+	std::reverse(backward.begin(), backward.end());
+	CHECK(forward == backward);
+	CHECK(forward.size() == list.Size());
+	return forward;
+}
+
+TEST_CASE(DoubleLinkedListSortMergeSplice)
+{
+	auto segment = std::make_shared<DynamicSegment>(64);
+	std::mt19937 rng(5);
+
+	for (int count : { 0, 1, 2, 3, 5, 17, 100, 1000, 4097 })
+	{
+		// Sort is stable
+		KeyValueList list{ SimpleNodeAllocator<KeyValue>(segment) };
+		std::vector<KeyValue> expected;
+		for (int i = 0; i < count; i++)
+		{
+			KeyValue element = { (int)(rng() % 50), i };
+			list.Add(element);
+			expected.push_back(element);
+		}
+		list.Sort(KeyLess());
+		std::stable_sort(expected.begin(), expected.end(), KeyLess());
+		CHECK(Elements(list) == expected);
+
+		// Merge takes all nodes of other, equal keys of this list go first
+		KeyValueList other{ SimpleNodeAllocator<KeyValue>(segment) };
+		std::vector<KeyValue> otherExpected;
+		for (int i = 0; i <= count / 2; i++)
+		{
+			KeyValue element = { (int)(rng() % 50), count + i };
+			other.Add(element);
+			otherExpected.push_back(element);
+		}
+		other.Sort(KeyLess());
+		std::stable_sort(otherExpected.begin(), otherExpected.end(), KeyLess());
+
+		std::vector<KeyValue> merged;
+		std::merge(expected.begin(), expected.end(), otherExpected.begin(), otherExpected.end(), std::back_inserter(merged), KeyLess());
+		CHECK(list.Merge(other, KeyLess()));
+		CHECK(Elements(list) == merged);
+		CHECK(Elements(other).empty());
+
+		if (merged.size() < 4)
+			continue;
+
+		// Move the second & third elements to other
+		auto first = list.cBegin();
+		++first;
+		auto last = first;
+		++last;
+		++last;
+		CHECK(other.Splice(other.cEnd(), list, first, last));
+
+		std::vector<KeyValue> moved(merged.begin() + 1, merged.begin() + 3);
+		merged.erase(merged.begin() + 1, merged.begin() + 3);
+		CHECK(Elements(other) == moved);
+		CHECK(Elements(list) == merged);
+
+		// Move them back to the front
+		CHECK(list.Splice(KeyValueList::const_iterator(list.Head()), other));
+		merged.insert(merged.begin(), moved.begin(), moved.end());
+		CHECK(Elements(list) == merged);
+		CHECK(other.Size() == 0);
+
+		// Move the first element to the end of the same list
+		first = list.cBegin();
+		last = first;
+		++last;
+		CHECK(list.Splice(list.cEnd(), list, first, last));
+		std::rotate(merged.begin(), merged.begin() + 1, merged.end());
+		CHECK(Elements(list) == merged);
+	}
+
+	// Pool lists created from the same allocator share its pool, their nodes can move between them
+	typedef DoubleLinkedList<int, PoolNodeAllocator<int>> PoolList;
+	auto poolSegment = std::make_shared<DynamicSegment>(8);
+	PoolNodeAllocator<int> shared(poolSegment, 16);
+	{
+		PoolList a(shared), b(shared);
+		for (int i = 0; i < 100; i++)
+			(i % 2 ? a : b).Add(i);
+		CHECK(a.GetAllocator().Shares(b.GetAllocator()));
+		CHECK(a.Merge(b) && a.Size() == 100 && b.Size() == 0);
+
+		int expected = 0;
+		bool sorted = true;
+		for (auto it = a.Begin(); it != a.End(); ++it, ++expected)
+			sorted = sorted && *it == expected;
+		CHECK(sorted);
+
+		auto first = a.cBegin();
+		auto last = first;
+		for (int i = 0; i < 10; i++)
+			++last;
+		CHECK(b.Splice(b.cEnd(), a, first, last) && a.Size() == 90 && b.Size() == 10 && b.Top() == 0);
+
+		// Later lists join the pool through the allocator of a list
+		PoolList c(a.GetAllocator());
+		CHECK(c.Splice(c.cEnd(), b) && c.Size() == 10);
+	}
+
+	// Lists of separate allocators own their pools, their nodes can not move to another list
+	PoolList a(PoolNodeAllocator<int>(poolSegment, 16));
+	PoolList b(PoolNodeAllocator<int>(poolSegment, 16));
+	a.Add(3);
+	a.Add(1);
+	b.Add(2);
+	CHECK(!a.GetAllocator().Shares(b.GetAllocator()));
+	CHECK(!a.Splice(a.cEnd(), b));
+	CHECK(!a.Merge(b));
+
+	a.Sort();
+	CHECK(a.Top() == 1 && a.Size() == 2 && b.Size() == 1);
+}
+
+TEST_CASE(MapKeepsKeysSorted)
+{
+	auto segment = std::make_shared<DynamicSegment>(8);
+
+	Map<int, int, PoolNodeAllocator<int>> map(PoolNodeAllocator<int>(segment, 16));
+	for (int i = 0; i < 100; i++)
+		map.Insert(Pair<int, int>(i * 37 % 100, i));
+
+	CHECK(map.Size() == 100);
+	CHECK(*map.Find(37) == 1);
+	CHECK(map.Find(100) == nullptr);
+
+	int expected = 0;
+	bool sorted = true;
+	for (auto it = map.Begin(); it != map.End(); ++it)
+		sorted = sorted && it->_first == expected++;
+	CHECK(sorted && expected == 100);
+}
+
+// Run random inserts, removes & finds on map and std::map, then compare them
+template <class MapType>
+static void CheckMapMatchesStdMap(MapType& map, uint32 seed)
+{
+	std::mt19937 rng(seed);
+	std::map<int, int> expected;
+
+	for (int step = 0; step < 4000; step++)
+	{
+		int key = rng() % 200;
+
+		switch (rng() % 3)
+		{
+		case 0:
+			if (expected.count(key) == 0)
+			{
+				map.Insert(Pair<int, int>(key, step));
+				expected[key] = step;
+			}
+			break;
+
+		case 1:
+			// Removing a node with two children moves its successor into it
+			map.Remove(key);
+			expected.erase(key);
+			break;
+
+		default:
+		{
+			auto found = expected.find(key);
+			int* value = map.Find(key);
+			CHECK((value != nullptr) == (found != expected.end()));
+			if (value && found != expected.end())
+				CHECK(*value == found->second);
+			break;
+		}
+		}
+	}
+
+	CHECK(map.Size() == expected.size());
+	auto found = expected.begin();
+	bool same = true;
+	for (auto it = map.Begin(); it != map.End() && same; ++it, ++found)
+		same = found != expected.end() && it->_first == found->first && it->_second == found->second;
+	CHECK(same && found == expected.end());
+}
+
+TEST_CASE(MapMatchesStdMap)
+{
+	auto segment = std::make_shared<DynamicSegment>(8);
+
+	Map<int, int, PoolNodeAllocator<int>> map(PoolNodeAllocator<int>(segment, 16));
+	CheckMapMatchesStdMap(map, 3);
+}
+
+// Pool tags, so each test starts with its own empty index pool
+struct ListIndexPool {};
+struct MapIndexPool {};
+struct SharedIndexPool {};
+
+TEST_CASE(DoubleLinkedListOnIndexNodes)
+{
+	typedef DoubleLinkedList<int, IndexNodeAllocator<int, ListIndexPool>> ListType;
+	auto segment = std::make_shared<DynamicSegment>(8);
+
+	// Start small so the pool is reallocated while nodes are linked
+	ListType list(IndexNodeAllocator<int, ListIndexPool>(segment, 4));
+	CheckListMatchesStdList(list, 4);
+}
+
+TEST_CASE(MapOnIndexNodes)
+{
+	typedef Map<int, int, IndexNodeAllocator<int, MapIndexPool>> MapType;
+	auto segment = std::make_shared<DynamicSegment>(8);
+
+	MapType map(IndexNodeAllocator<int, MapIndexPool>(segment, 4));
+	CheckMapMatchesStdMap(map, 5);
+
+	// Both maps allocate from the pool of their node type
+	MapType copy(map);
+	CHECK(copy.Size() == map.Size());
+	CHECK(std::equal(map.Begin(), map.End(), copy.Begin(), [](const Pair<int, int>& a, const Pair<int, int>& b)
+		{ return a._first == b._first && a._second == b._second; }));
+}
+
+TEST_CASE(IndexNodePoolLivesWithItsAllocators)
+{
+	typedef DoubleLinkedList<int, IndexNodeAllocator<int, SharedIndexPool>> ListType;
+	typedef ListType::Allocator::Pool Pool;
+	auto segment = std::make_shared<DynamicSegment>(8);
+	auto otherSegment = std::make_shared<DynamicSegment>(8);
+
+	{
+		ListType first(IndexNodeAllocator<int, SharedIndexPool>(segment, 4));
+		for (int i = 0; i < 1000; i++)
+			first.Add(i);
+
+		{
+			// A later allocator from another segment joins the live pool
+			ListType second(IndexNodeAllocator<int, SharedIndexPool>(otherSegment, 4));
+			CHECK(second.GetAllocator().GetSegmentManager() == segment);
+			CHECK(second.GetAllocator().Shares(first.GetAllocator()));
+
+			for (int i = 0; i < 1000; i++)
+				second.Add(-i);
+
+			// Nodes of lists sharing the pool can move between them
+			CHECK(first.Splice(first.cEnd(), second));
+			CHECK(first.Size() == 2000 && second.Size() == 0);
+
+			second.Add(7);
+		}
+
+		// The pool outlives the destroyed list, the nodes of first are still valid
+		CHECK(!Pool::instance.expired());
+		int expected = 0;
+		bool same = true;
+		for (auto it = first.Begin(); it != first.End(); ++it, ++expected)
+			same = same && *it == (expected < 1000 ? expected : 1000 - expected);
+		CHECK(same && expected == 2000);
+	}
+
+	// The last list released the pool
+	CHECK(Pool::instance.expired() && Pool::current == nullptr);
+
+	ListType list(IndexNodeAllocator<int, SharedIndexPool>(otherSegment, 4));
+	list.Add(1);
+	CHECK(list.GetAllocator().GetSegmentManager() == otherSegment && list.Top() == 1);
+
+	// A failed expand keeps the pool & its nodes
+	list.Reserve(0xF0000000);
+	list.Add(2);
+	CHECK(list.Size() == 2 && *list.Begin() == 1 && *++list.Begin() == 2);
+}
+
+// Return true if the elements of the range are laid out in memory
+// in traversal order, at a constant stride
+template <class Iterator>
+static bool IsContiguous(Iterator first, Iterator last)
+{
+	SIZE_T stride = 0;
+	const ubyte* previous = nullptr;
+	for (; first != last; ++first)
+	{
+		const ubyte* current = (const ubyte*)&*first;
+		if (previous && (current <= previous || (stride && (SIZE_T)(current - previous) != stride)))
+			return false;
+
+		if (previous)
+			stride = current - previous;
+		previous = current;
+	}
+
+	return true;
+}
+
+TEST_CASE(ReservedListNodesAreContiguous)
+{
+	auto segment = std::make_shared<DynamicSegment>(8);
+
+	DoubleLinkedList<int, PoolNodeAllocator<int>> source(PoolNodeAllocator<int>(segment, 16));
+	for (int i = 0; i < 1000; i++)
+		source.AddFront(i);
+
+	// Nodes added at the front are laid out backwards
+	CHECK(!IsContiguous(source.Begin(), source.End()));
+
+	// Append reserves the source size first, so the nodes are allocated in the source order
+	DoubleLinkedList<int, PoolNodeAllocator<int>> list(source, PoolNodeAllocator<int>(segment, 16));
+	CHECK(list.Size() == 1000);
+	CHECK(IsContiguous(list.Begin(), list.End()));
+
+	bool same = true;
+	auto from = source.Begin();
+	for (auto it = list.Begin(); it != list.End(); ++it, ++from)
+		same = same && *it == *from;
+	CHECK(same);
+
+	// Recycled nodes are skipped while a reservation is pending
+	for (int i = 0; i < 10; i++)
+		list.Pop();
+	list.Reserve(10);
+	for (int i = 0; i < 10; i++)
+		list.Add(i);
+	CHECK(list.Size() == 1000);
+
+	auto last = list.Begin();
+	for (int i = 0; i < 990; i++)
+		++last;
+	CHECK(*last == 0 && IsContiguous(last, list.End()));
+}
+
+TEST_CASE(TreeFromContainerAndAppend)
+{
+	typedef Tree<MapTraits<int, int>, PoolNodeAllocator<int>> TreeType;
+	auto segment = std::make_shared<DynamicSegment>(8);
+
+	DoubleLinkedList<Pair<int, int>, PoolNodeAllocator<int>> source(PoolNodeAllocator<int>(segment, 16));
+	for (int i = 0; i < 500; i++)
+		source.Add(Pair<int, int>(i, i * 2));
+
+	// Sorted values inserted after Reserve lay the nodes out in traversal order
+	TreeType tree(source, PoolNodeAllocator<int>(segment, 4));
+	CHECK(tree.Size() == 500);
+	CHECK(tree.Find(499) && *tree.Find(499) == 998);
+	CHECK(IsContiguous(tree.Begin(), tree.End()));
+
+	TreeType copy(PoolNodeAllocator<int>(segment, 4));
+	copy.Append(tree);
+	CHECK(copy.Size() == 500 && IsContiguous(copy.Begin(), copy.End()));
+
+	int expected = 0;
+	bool sorted = true;
+	for (auto it = copy.Begin(); it != copy.End(); ++it, ++expected)
+		sorted = sorted && it->_first == expected && it->_second == expected * 2;
+	CHECK(sorted && expected == 500);
+
+	// Reserved nodes are used in order by the next inserts
+	TreeType reserved(PoolNodeAllocator<int>(segment, 4));
+	reserved.Reserve(100);
+	for (int i = 0; i < 100; i++)
+		reserved.Insert(Pair<int, int>(i, -i));
+	CHECK(reserved.Size() == 100 && IsContiguous(reserved.Begin(), reserved.End()));
+
+	// Allocators without a pool ignore Reserve
+	typedef Tree<MapTraits<int, int>, SimpleNodeAllocator<int>> SimpleTreeType;
+	SimpleTreeType simple(source, SimpleNodeAllocator<int>(segment));
+	SimpleTreeType appended{ SimpleNodeAllocator<int>(segment) };
+	appended.Append(simple);
+	CHECK(simple.Size() == 500 && appended.Size() == 500 && appended.Find(250) && *appended.Find(250) == 500);
+}
+
+TEST_CASE(PoolNodeAllocatorGrowsInPlace)
+{
+	auto segment = std::make_shared<DynamicSegment>(8);
+
+	{
+		// The pool is the last chunk, so it can always expand in place
+		DoubleLinkedList<int, PoolNodeAllocator<int>> list(PoolNodeAllocator<int>(segment, 4));
+		for (int i = 0; i < 10000; i++)
+			list.Add(i);
+
+		CHECK(list.Size() == 10000);
+		int expected = 0;
+		bool same = true;
+		for (auto it = list.Begin(); it != list.End(); ++it)
+			same = same && *it == expected++;
+		CHECK(same && expected == 10000);
+	}
+
+	{
+		// An allocation right after the pool stops it from growing,
+		// adds then fail instead of writing past the pool
+		DoubleLinkedList<int, PoolNodeAllocator<int>> list(PoolNodeAllocator<int>(segment, 4));
+		UINTPTR guard = segment->Alloc(4096);
+		memset(DynamicSegment::PointerOf(guard), 0x5a, 4096);
+
+		uint32 added = 0;
+		for (int i = 0; i < 1000; i++)
+			if (list.Add(i) != list.cEnd())
+				++added;
+
+		const ubyte* bytes = (const ubyte*)DynamicSegment::PointerOf(guard);
+		CHECK(std::all_of(bytes, bytes + 4096, [](ubyte b) { return b == 0x5a; }));
+		CHECK(added < 1000 && list.Size() == added);
+		segment->Dealloc(guard);
+	}
+}
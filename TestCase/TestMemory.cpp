@@ -0,0 +1,347 @@
+/*****************************************************************************
+The MIT License(MIT)
+
+Copyright(c) 2016 Amr Esam
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*********************************************************************************/
+#include "TestCase.h"
+#include "../boxyto/memory/DynamicSegment.h"
+#include "../boxyto/memory/MemoryOps.h"
+#include "../boxyto/memory/MemoryResource.h"
+#include "../boxyto/memory/StdAllocator.h"
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <list>
+#include <map>
+#include <memory>
+#include <random>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+using namespace Everest;
+
+// A live segment allocation & the byte it was filled with
+struct Allocation
+{
+	UINTPTR handle;
+	SIZE_T size;
+	uint32 alignment;
+	ubyte fill;
+};
+
+// Return true if all bytes of an allocation still hold its fill byte
+static bool Holds(const Allocation& allocation, SIZE_T size)
+{
+	const ubyte* bytes = (const ubyte*)DynamicSegment::PointerOf(allocation.handle);
+	return std::count(bytes, bytes + size, allocation.fill) == (std::ptrdiff_t)size;
+}
+
+// Return true if no two live allocations overlap
+static bool Disjoint(const std::vector<Allocation>& live)
+{
+	std::vector<std::pair<const ubyte*, const ubyte*>> ranges;
+	for (const Allocation& allocation : live)
+	{
+		const ubyte* start = (const ubyte*)DynamicSegment::PointerOf(allocation.handle);
+		ranges.push_back(std::make_pair(start, start + allocation.size));
+	}
+
+	std::sort(ranges.begin(), ranges.end());
+	for (size_t i = 1; i < ranges.size(); i++)
+		if (ranges[i].first < ranges[i - 1].second)
+			return false;
+	return true;
+}
+
+TEST_CASE(DynamicSegmentReusesFreeChunks)
+{
+	DynamicSegment segment(16);
+	std::mt19937 rng(1);
+	std::vector<Allocation> live;
+
+	for (int step = 0; step < 20000; step++)
+	{
+		switch (live.empty() ? 0 : rng() % 3)
+		{
+		case 0:
+		{
+			Allocation allocation = { 0, 1 + rng() % 5000, 16u << (rng() % 3), (ubyte)rng() };
+			allocation.handle = segment.Alloc(allocation.size, allocation.alignment);
+			CHECK(allocation.handle != 0);
+			if (!allocation.handle)
+				break;
+
+			CHECK((UINTPTR)DynamicSegment::PointerOf(allocation.handle) % allocation.alignment == 0);
+			memset(DynamicSegment::PointerOf(allocation.handle), allocation.fill, allocation.size);
+			live.push_back(allocation);
+			break;
+		}
+
+		case 1:
+		{
+			size_t index = rng() % live.size();
+			CHECK(Holds(live[index], live[index].size));
+			segment.Dealloc(live[index].handle);
+			live[index] = live.back();
+			live.pop_back();
+			break;
+		}
+
+		default:
+		{
+			Allocation& allocation = live[rng() % live.size()];
+			SIZE_T size = 1 + rng() % 8000;
+			UINTPTR handle = segment.Realloc(allocation.handle, size, allocation.alignment);
+			CHECK(handle != 0);
+			if (!handle)
+				break;
+
+			SIZE_T kept = std::min(size, allocation.size);
+			allocation.handle = handle;
+			CHECK(Holds(allocation, kept));
+			memset(DynamicSegment::PointerOf(handle), allocation.fill, size);
+			allocation.size = size;
+			break;
+		}
+		}
+
+		if (step % 100 == 0)
+			CHECK(Disjoint(live));
+	}
+
+	CHECK(Disjoint(live));
+	for (const Allocation& allocation : live)
+		CHECK(Holds(allocation, allocation.size));
+}
+
+TEST_CASE(DynamicStdAllocatorReleasesMemory)
+{
+	auto segment = std::make_shared<DynamicSegment>(1);
+
+	// Each round grows a vector through many buffers, a leak would exhaust the segment
+	bool same = true;
+	for (int round = 0; round < 500; round++)
+	{
+		std::vector<int, DynamicStdAllocator<int>> vector((DynamicStdAllocator<int>(segment)));
+		for (int i = 0; i < 10000; i++)
+			vector.push_back(i);
+
+		same = same && vector.size() == 10000 && vector.back() == 9999;
+	}
+	CHECK(same);
+
+	// Node containers rebind the allocator to their node type
+	typedef DynamicStdAllocator<std::pair<const int, int>> PairAllocator;
+	std::map<int, int, std::less<int>, PairAllocator> map((PairAllocator(segment)));
+	for (int i = 0; i < 1000; i++)
+		map[i] = i * 2;
+	CHECK(map.size() == 1000 && map[999] == 1998);
+
+	CHECK(DynamicStdAllocator<int>(segment) == PairAllocator(segment));
+	CHECK(DynamicStdAllocator<int>(segment) != DynamicStdAllocator<int>(std::make_shared<DynamicSegment>(1)));
+
+	// Move only elements are moved & emplaced through construct
+	typedef std::unique_ptr<int> Owner;
+	std::vector<Owner, DynamicStdAllocator<Owner>> owners((DynamicStdAllocator<Owner>(segment)));
+	for (int i = 0; i < 1000; i++)
+		owners.emplace_back(new int(i));
+	owners.push_back(Owner(new int(1000)));
+	CHECK(owners.size() == 1001 && *owners[500] == 500 && *owners.back() == 1000);
+
+	std::map<int, Owner, std::less<int>, DynamicStdAllocator<std::pair<const int, Owner>>> owned((DynamicStdAllocator<std::pair<const int, Owner>>(segment)));
+	owned.emplace(1, Owner(new int(10)));
+	owned.emplace(std::piecewise_construct, std::forward_as_tuple(2), std::forward_as_tuple(new int(20)));
+	CHECK(owned.size() == 2 && *owned[2] == 20);
+}
+
+TEST_CASE(SegmentResourcesBackPmrContainers)
+{
+	auto dynamicSegment = std::make_shared<DynamicSegment>(1);
+	auto staticSegment = std::make_shared<StaticSegment>(1);
+
+	// Growing through a one page segment many times only fits if buffers are freed
+	DynamicSegmentResource dynamicResource(dynamicSegment);
+	bool same = true;
+	for (int round = 0; round < 500; round++)
+	{
+		std::pmr::vector<int> vector(&dynamicResource);
+		for (int i = 0; i < 10000; i++)
+			vector.push_back(i);
+		same = same && vector.back() == 9999;
+	}
+	CHECK(same);
+	CHECK(dynamicResource.is_equal(DynamicSegmentResource(dynamicSegment)));
+
+	StaticSegmentResource staticResource(staticSegment);
+	std::pmr::vector<int> vector(&staticResource);
+	for (int i = 0; i < 1000; i++)
+		vector.push_back(i);
+	CHECK(vector.size() == 1000 && vector[999] == 999);
+}
+
+TEST_CASE(NodePoolResourceRecyclesBlocks)
+{
+	auto segment = std::make_shared<DynamicSegment>(1);
+	NodePoolResource resource(segment, 24, 4);
+	CHECK(resource.GetBlockSize() == 32);
+
+	// Blocks are carved in order, the next chunk is allocated when the current is used up
+	void* blocks[6];
+	for (int i = 0; i < 6; i++)
+		blocks[i] = resource.allocate(24, 8);
+	CHECK((ubyte*)blocks[1] - (ubyte*)blocks[0] == 32);
+	CHECK((ubyte*)blocks[3] - (ubyte*)blocks[2] == 32);
+
+	resource.deallocate(blocks[2], 24, 8);
+	resource.deallocate(blocks[4], 24, 8);
+	CHECK(resource.allocate(24, 8) == blocks[4]);
+	CHECK(resource.allocate(16, 8) == blocks[2]);
+
+	// Larger requests go to the segment
+	void* large = resource.allocate(4096, 16);
+	CHECK(large != nullptr);
+	resource.deallocate(large, 4096, 16);
+
+	NodePoolResource listResource(segment, sizeof(void*) * 3);
+	std::pmr::list<int> list(&listResource);
+	for (int i = 0; i < 10000; i++)
+		list.push_back(i);
+	for (int i = 0; i < 5000; i++)
+		list.pop_front();
+	for (int i = 0; i < 5000; i++)
+		list.push_back(i);
+	CHECK(list.size() == 10000 && list.front() == 5000 && list.back() == 4999);
+}
+
+// Run the memory kernels and the CRT functions on copies of the same random bytes,
+// for sizes from first to last and every source & destination offset in a vector
+//
+// @return: true if all kernels match the CRT
+static bool KernelsMatchCrt(SIZE_T first, SIZE_T last, SIZE_T step, std::mt19937& rng)
+{
+	const SIZE_T MAX_OFFSET = 64;
+	std::vector<ubyte> source(last + MAX_OFFSET * 2), kernel, crt;
+	for (ubyte& byte : source)
+		byte = (ubyte)rng();
+
+	for (SIZE_T size = first; size <= last; size += step)
+	{
+		SIZE_T from = rng() % MAX_OFFSET, to = rng() % MAX_OFFSET;
+
+		kernel = crt = source;
+		SimdMemory::Copy(&kernel[to], &source[from], size);
+		memcpy(&crt[to], &source[from], size);
+		if (kernel != crt)
+			return false;
+
+		// Overlapping moves, both directions
+		SimdMemory::Move(&kernel[to], &kernel[from], size);
+		memmove(&crt[to], &crt[from], size);
+		if (kernel != crt)
+			return false;
+
+		int32 value = (int32)rng();
+		SimdMemory::Fill(&kernel[from], value, size);
+		memset(&crt[from], value, size);
+		if (kernel != crt)
+			return false;
+
+		// Equal bytes, then one byte changed
+		kernel = source;
+		if (size)
+			kernel[to + rng() % size] ^= (ubyte)(1 + rng() % 255);
+		int32 result = SimdMemory::Compare(&kernel[to], &source[to], size);
+		int32 expected = memcmp(&kernel[to], &source[to], size);
+		if ((result < 0) != (expected < 0) || (result > 0) != (expected > 0))
+			return false;
+	}
+
+	return true;
+}
+
+TEST_CASE(SimdKernelsMatchCrt)
+{
+	std::mt19937 rng(4);
+
+	// Sizes around the 16, 32 & 64 bytes vectors, head & tail stores
+	for (int round = 0; round < 20; round++)
+		CHECK(KernelsMatchCrt(0, 300, 1, rng));
+	CHECK(KernelsMatchCrt(300, 70000, 997, rng));
+
+	// Sizes around the non-temporal stores threshold
+	SIZE_T threshold = SimdMemory::GetStreamThreshold();
+	SimdMemory::SetStreamThreshold(4096);
+	CHECK(KernelsMatchCrt(4096 - 130, 4096 + 130, 1, rng));
+	CHECK(KernelsMatchCrt(900000, 900000, 1, rng));
+	SimdMemory::SetStreamThreshold(threshold);
+}
+
+// Element that counts its copies & destructions
+struct Tracked
+{
+	Tracked(int value) : value(value) {}
+	Tracked(const Tracked& other) : value(other.value) { ++copies; }
+	~Tracked() { ++destroyed; }
+
+	int value;
+	static int copies, destroyed;
+};
+int Tracked::copies = 0;
+int Tracked::destroyed = 0;
+
+TEST_CASE(RangeOpsMatchElementWiseOps)
+{
+	static_assert(IsTriviallyCopyable<int>::value && IsTriviallyDestructible<double>::value, "numeric types are trivial");
+	static_assert(!IsTriviallyCopyable<Tracked>::value && !IsTriviallyDestructible<Tracked>::value, "Tracked is not trivial");
+
+	// Byte & zero values are filled, other values copied
+	int ints[100];
+	ConstructRange(ints, 0, 100);
+	CHECK(std::count(ints, ints + 100, 0) == 100);
+	ConstructRange(ints, 0x01020304, 100);
+	CHECK(std::count(ints, ints + 100, 0x01020304) == 100);
+
+	ubyte bytes[33];
+	ConstructRange(bytes, (ubyte)7, 33);
+	CHECK(std::count(bytes, bytes + 33, 7) == 33);
+
+	const int source[5] = { 1, 2, 3, 4, 5 };
+	int dest[8] = {};
+	ConstructRangeFromRange(source, dest, 5, 2);
+	CHECK(dest[1] == 0 && dest[2] == 1 && dest[6] == 5 && dest[7] == 0);
+	Destroy(dest, 8);
+
+	// Non trivial elements are copied & destroyed one by one
+	alignas(Tracked) ubyte memory[sizeof(Tracked) * 10];
+	Tracked* tracked = (Tracked*)memory;
+	ConstructRange(tracked, Tracked(9), 4);
+	CHECK(Tracked::copies == 4 && tracked[3].value == 9);
+
+	ConstructRangeFromRange((const Tracked*)tracked, tracked, 4, 4);
+	CHECK(Tracked::copies == 8 && tracked[7].value == 9);
+
+	int destroyed = Tracked::destroyed;
+	Destroy(tracked, 8);
+	CHECK(Tracked::destroyed == destroyed + 8);
+}
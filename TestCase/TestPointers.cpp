@@ -0,0 +1,312 @@
+/*****************************************************************************
+The MIT License(MIT)
+
+Copyright(c) 2016 Amr Esam
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*********************************************************************************/
+#include "TestCase.h"
+#include "../boxyto/memory/Pointer.h"
+#include "../boxyto/memory/SmartPointers.h"
+
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace Everest;
+
+// Object that counts its live instances
+struct Counted
+{
+	Counted(int value) : value(value) { ++live; }
+	virtual ~Counted() { --live; }
+
+	int value;
+	static int live;
+};
+int Counted::live = 0;
+
+// Derived object, to share through a base pointer
+struct DerivedCounted : Counted
+{
+	DerivedCounted(int value, int extra) : Counted(value), extra(extra) {}
+
+	int extra;
+};
+
+TEST_CASE(MakeSharedReleasesWithLastReference)
+{
+	DynamicSegment segment(1);
+
+	{
+		SharedPointer<DerivedCounted> shared = MakeShared<DerivedCounted>(segment, 5, 6);
+		CHECK(shared.UseCount() == 1 && shared->value == 5 && shared->extra == 6);
+
+		// Converting copies share one control block
+		SharedPointer<Counted> base = shared;
+		CHECK(shared.UseCount() == 2 && base.UseCount() == 2);
+
+		SharedPointer<Counted> other(new Counted(7));
+		other = base;
+		CHECK(Counted::live == 1 && base.UseCount() == 3);
+
+		SharedPointer<Counted> moved(static_cast<SharedPointer<Counted>&&>(other));
+		CHECK(other.UseCount() == 0 && moved.UseCount() == 3);
+
+		shared.Reset();
+		base.Reset();
+		CHECK(Counted::live == 1 && moved.UseCount() == 1 && moved->value == 5);
+	}
+	CHECK(Counted::live == 0);
+
+	// Object & control block go back to the segment, a leak would exhaust one page
+	bool allocated = true;
+	for (int i = 0; i < 100000 && allocated; i++)
+		allocated = MakeShared<Counted>(segment, i).Get() != nullptr;
+	CHECK(allocated && Counted::live == 0);
+
+	StaticSegment staticSegment(1);
+	{
+		auto shared = MakeShared<Counted>(staticSegment, 1);
+		auto copy = shared;
+		CHECK(copy.UseCount() == 2 && Counted::live == 1);
+	}
+	CHECK(Counted::live == 0);
+}
+
+TEST_CASE(SharedPointerCountsAcrossThreads)
+{
+	DynamicSegment segment(1);
+	SharedPointer<Counted> shared = MakeShared<Counted>(segment, 1);
+
+	// Copies made & released concurrently must leave the count balanced
+	std::vector<std::thread> threads;
+	for (int t = 0; t < 4; t++)
+		threads.emplace_back([&shared]()
+		{
+			for (int i = 0; i < 100000; i++)
+			{
+				SharedPointer<Counted> copy = shared;
+				(void)copy;
+			}
+		});
+	for (std::thread& thread : threads)
+		thread.join();
+
+	CHECK(shared.UseCount() == 1 && Counted::live == 1);
+	shared.Reset();
+	CHECK(Counted::live == 0);
+}
+
+TEST_CASE(SharedPointerCountPolicies)
+{
+	DynamicSegment segment(1);
+
+	{
+		auto shared = MakeShared<Counted, RefCountNonAtomic>(segment, 1);
+		auto copy = shared;
+		CHECK(copy.UseCount() == 2);
+	}
+	CHECK(Counted::live == 0);
+
+	// Owner thread only, the last release destroys the object
+	{
+		auto shared = MakeShared<Counted, RefCountBiased>(segment, 2);
+		auto copy = shared;
+		CHECK(shared.UseCount() == 2);
+		shared.Reset();
+		CHECK(Counted::live == 1 && copy.UseCount() == 1);
+	}
+	CHECK(Counted::live == 0);
+
+	// Other thread copies & releases, the owner releases last
+	{
+		auto shared = MakeShared<Counted, RefCountBiased>(segment, 3);
+		std::thread([&shared]()
+		{
+			auto copy = shared;
+			copy.Reset();
+		}).join();
+		CHECK(Counted::live == 1 && shared.UseCount() == 1);
+	}
+	CHECK(Counted::live == 0);
+}
+
+TEST_CASE(BiasedReleasedByOtherThreadIsQueuedToOwner)
+{
+	DynamicSegment segment(1);
+
+	// The owner copy is released by another thread before the owner releases its own
+	auto shared = MakeShared<Counted, RefCountBiased>(segment, 1);
+	SharedPointer<Counted, RefCountBiased> copy = shared;
+	std::thread([&copy]() { copy.Reset(); }).join();
+
+	shared.Reset();
+	CHECK(Counted::live == 1);
+
+	// The owner merges the queued count and destroys the object
+	RefCountBiased::MergeQueued();
+	CHECK(Counted::live == 0);
+
+	// Many threads release copies while the owner releases & merges
+	for (int round = 0; round < 100; round++)
+	{
+		auto object = MakeShared<Counted, RefCountBiased>(segment, round);
+		std::vector<SharedPointer<Counted, RefCountBiased>> copies(8, object);
+
+		std::vector<std::thread> threads;
+		for (int t = 0; t < 8; t++)
+			threads.emplace_back([&copies, t]()
+			{
+				for (int i = 0; i < 1000; i++)
+				{
+					auto copy = copies[t];
+					(void)copy;
+				}
+				copies[t].Reset();
+			});
+
+		if (round % 2)
+			object.Reset();
+		for (std::thread& thread : threads)
+			thread.join();
+
+		object.Reset();
+		RefCountBiased::MergeQueued();
+	}
+	CHECK(Counted::live == 0);
+}
+
+TEST_CASE(BiasedOutlivesItsOwnerThread)
+{
+	DynamicSegment segment(1);
+
+	// Owner references are handed to this thread, then the owner finishes
+	SharedPointer<Counted, RefCountBiased> first, second;
+	std::thread([&]()
+	{
+		first = MakeShared<Counted, RefCountBiased>(segment, 1);
+		second = first;
+	}).join();
+
+	CHECK(Counted::live == 1);
+	first.Reset();
+	CHECK(Counted::live == 1);
+
+	// Released after the owner finished, this thread merges the owner count
+	second.Reset();
+	CHECK(Counted::live == 0);
+
+	// Queued by another thread & never merged by the owner, merged when the owner finishes
+	std::thread([&segment]()
+	{
+		auto shared = MakeShared<Counted, RefCountBiased>(segment, 2);
+		SharedPointer<Counted, RefCountBiased> copy = shared;
+		std::thread([&copy]() { copy.Reset(); }).join();
+		shared.Reset();
+		CHECK(Counted::live == 1);
+	}).join();
+	CHECK(Counted::live == 0);
+
+	// Threads started after the owner finished are not taken for the owner
+	for (int round = 0; round < 20; round++)
+	{
+		SharedPointer<Counted, RefCountBiased> object;
+		std::thread([&]() { object = MakeShared<Counted, RefCountBiased>(segment, round); }).join();
+		std::thread([&object]()
+		{
+			auto copy = object;
+			CHECK(copy.UseCount() >= 1);
+			RefCountBiased::MergeQueued();
+		}).join();
+		object.Reset();
+		CHECK(Counted::live == 0);
+	}
+}
+
+// Over aligned object, so the segment header is padded
+struct alignas(32) AlignedCounted : Counted
+{
+	AlignedCounted(int value) : Counted(value) {}
+};
+
+TEST_CASE(UniquePointerDeletesToItsSegment)
+{
+	static_assert(sizeof(UniquePointer<Counted, SegmentDeleter<DynamicSegment>>) == sizeof(void*),
+		"deleters are not stored");
+
+	DynamicSegment segment(1);
+	StaticSegment staticSegment(1);
+
+	{
+		auto dynamicObject = MakeUnique<AlignedCounted>(segment, 1);
+		auto staticObject = MakeUnique<Counted>(staticSegment, 2);
+		UniquePointer<Counted> heapObject(new Counted(3));
+
+		CHECK((UINTPTR)dynamicObject.Get() % 32 == 0);
+		CHECK(dynamicObject->value == 1 && staticObject->value == 2 && heapObject->value == 3);
+		CHECK(Counted::live == 3);
+
+		// Moves transfer ownership, assignment deletes the old object
+		auto moved = static_cast<decltype(dynamicObject)&&>(dynamicObject);
+		CHECK(dynamicObject.Get() == nullptr && moved->value == 1);
+		moved = MakeUnique<AlignedCounted>(segment, 4);
+		CHECK(Counted::live == 3 && moved->value == 4);
+
+		Counted* released = heapObject.Release();
+		CHECK(heapObject.Get() == nullptr);
+		heapObject.Reset(released);
+	}
+	CHECK(Counted::live == 0);
+
+	// Objects go back to the segment, a leak would exhaust one page
+	bool allocated = true;
+	for (int i = 0; i < 100000 && allocated; i++)
+		allocated = MakeUnique<Counted>(segment, i).Get() != nullptr;
+	CHECK(allocated && Counted::live == 0);
+}
+
+TEST_CASE(CachedPointerResolvesAgainAfterDefragment)
+{
+	DynamicSegment segment(1);
+	UINTPTR first = segment.Alloc(sizeof(int));
+	UINTPTR second = segment.Alloc(sizeof(int));
+	*(int*)DynamicSegment::PointerOf(first) = 1;
+	*(int*)DynamicSegment::PointerOf(second) = 2;
+
+	CachedPointer<int> cached((Pointer<int>(first)));
+	CachedPointer<int> empty;
+	CHECK(*cached.Get() == 1 && empty.Get() == nullptr);
+
+	// Move the first allocation like a compaction does, a handle points to its chunk descriptor
+	// that starts with the mapped address
+	std::swap(*(void**)first, *(void**)second);
+
+	// The cached address is used until the epoch changes
+	CHECK(*cached.Get() == 1);
+	uint32 epoch = DynamicSegment::GetEpoch();
+	segment.Defragment();
+	CHECK(DynamicSegment::GetEpoch() == epoch + 1);
+	CHECK(*cached.Get() == 2 && cached.Get() == DynamicSegment::PointerOf(first));
+
+	std::swap(*(void**)first, *(void**)second);
+	segment.Dealloc(first);
+	segment.Dealloc(second);
+}
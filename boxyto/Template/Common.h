@@ -59,6 +59,65 @@ namespace Everest
 		typedef T1 Type;
 	};
 
+	// Compile time bool value, just like std::integral_constant<bool, Value>
+	template <bool Value>
+	struct BoolConstant
+	{
+		enum { value = Value };
+	};
+
+	// True if T can be copied with memcpy, just like std::is_trivially_copyable
+	template < class T >
+	struct IsTriviallyCopyable :
+		BoolConstant<__is_trivially_copyable(T)>
+	{};
+
+	// True if T destructor does nothing, just like std::is_trivially_destructible
+	template < class T >
+	struct IsTriviallyDestructible :
+#if defined(__clang__) || defined(_MSC_VER)
+		BoolConstant<__is_trivially_destructible(T)>
+#else
+		BoolConstant<__has_trivial_destructor(T)>
+#endif
+	{};
+
+	// Select the type at Index from a type list, TypeAt<1, int, float>::Type is float
+	template < uint32 Index, class... Types >
+	struct TypeAt;
+	template < class T, class... Types >
+	struct TypeAt<0, T, Types...>
+	{
+		typedef T Type;
+	};
+	template < uint32 Index, class T, class... Types >
+	struct TypeAt<Index, T, Types...>
+	{
+		typedef typename TypeAt<Index - 1, Types...>::Type Type;
+	};
+
+	// True if T1 & T2 are the same type, just like std::is_same
+	template < class T1, class T2 >
+	struct IsSame :
+		BoolConstant<false>
+	{};
+	template < class T >
+	struct IsSame<T, T> :
+		BoolConstant<true>
+	{};
+
+	// RemoveConst struct
+	template < class T >
+	struct RemoveConst
+	{
+		typedef T type;
+	};
+	template < class T >
+	struct RemoveConst<const T>
+	{
+		typedef T type;
+	};
+
 	// RemoveReference struct
 	template < class T >
 	struct RemoveReference
@@ -100,6 +159,15 @@ namespace Everest
 		return (typename RemoveReference<T>::type&&)arg;
 	}
 
+	// Swap two values by moving them, just like std::swap
+	template < class T >
+	_INLINE void Swap(T& left, T& right)
+	{
+		T temp = _EVEREST Move(left);
+		left = _EVEREST Move(right);
+		right = _EVEREST Move(temp);
+	}
+
 	// Check an integral-type's bit status
 	//
 	// @param: val - The integral value to check
@@ -0,0 +1,459 @@
+/*****************************************************************************
+The MIT License(MIT)
+
+Copyright(c) 2016 Amr Esam
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*********************************************************************************/
+#pragma once
+
+#include "../system.h"
+
+/* For reading keys as lane integers */
+#include <cstring>
+
+// SIMD find is selected at compile time, SSE2 is always available on x64 & on x86 built for it,
+// AVX2 is used when the compiler targets it (/arch:AVX2 or -mavx2)
+#if defined(_M_X64) || defined(__x86_64__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2) || defined(__SSE2__)
+#define SIMD_FIND_SSE2
+#include <emmintrin.h>
+#if defined(__AVX2__)
+#define SIMD_FIND_AVX2
+#include <immintrin.h>
+#endif
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+namespace Everest
+{
+	// Compare lanes for a key type, keys with no lanes are compared by operator ==
+	template < class T >
+	struct FindLane
+	{
+		enum { SIMD = false };
+	};
+
+#if defined(SIMD_FIND_SSE2)
+
+	// Return index of the lowest set bit in a non zero mask
+	_INLINE uint32 LowestBit(uint32 mask)
+	{
+#if defined(_MSC_VER)
+		unsigned long index;
+		_BitScanForward(&index, mask);
+		return index;
+#else
+		return (uint32)__builtin_ctz(mask);
+#endif
+	}
+
+	// Return index of the highest set bit in a non zero mask
+	_INLINE uint32 HighestBit(uint32 mask)
+	{
+#if defined(_MSC_VER)
+		unsigned long index;
+		_BitScanReverse(&index, mask);
+		return index;
+#else
+		return 31 - (uint32)__builtin_clz(mask);
+#endif
+	}
+
+	// Integer lanes of SIZE bytes
+	template < uint32 SIZE >
+	struct FindIntLane;
+
+	template <>
+	struct FindIntLane<1>
+	{
+		enum { SIMD = true };
+
+		template < class T >
+		_INLINE static __m128i Broadcast(const T& value)
+		{
+			int8 key; memcpy(&key, &value, sizeof(key));
+			return _mm_set1_epi8(key);
+		}
+
+		_INLINE static __m128i Equal(__m128i a, __m128i b) { return _mm_cmpeq_epi8(a, b); }
+
+#if defined(SIMD_FIND_AVX2)
+		template < class T >
+		_INLINE static __m256i Broadcast256(const T& value)
+		{
+			int8 key; memcpy(&key, &value, sizeof(key));
+			return _mm256_set1_epi8(key);
+		}
+
+		_INLINE static __m256i Equal256(__m256i a, __m256i b) { return _mm256_cmpeq_epi8(a, b); }
+#endif
+	};
+
+	template <>
+	struct FindIntLane<2>
+	{
+		enum { SIMD = true };
+
+		template < class T >
+		_INLINE static __m128i Broadcast(const T& value)
+		{
+			int16 key; memcpy(&key, &value, sizeof(key));
+			return _mm_set1_epi16(key);
+		}
+
+		_INLINE static __m128i Equal(__m128i a, __m128i b) { return _mm_cmpeq_epi16(a, b); }
+
+#if defined(SIMD_FIND_AVX2)
+		template < class T >
+		_INLINE static __m256i Broadcast256(const T& value)
+		{
+			int16 key; memcpy(&key, &value, sizeof(key));
+			return _mm256_set1_epi16(key);
+		}
+
+		_INLINE static __m256i Equal256(__m256i a, __m256i b) { return _mm256_cmpeq_epi16(a, b); }
+#endif
+	};
+
+	template <>
+	struct FindIntLane<4>
+	{
+		enum { SIMD = true };
+
+		template < class T >
+		_INLINE static __m128i Broadcast(const T& value)
+		{
+			int32 key; memcpy(&key, &value, sizeof(key));
+			return _mm_set1_epi32(key);
+		}
+
+		_INLINE static __m128i Equal(__m128i a, __m128i b) { return _mm_cmpeq_epi32(a, b); }
+
+#if defined(SIMD_FIND_AVX2)
+		template < class T >
+		_INLINE static __m256i Broadcast256(const T& value)
+		{
+			int32 key; memcpy(&key, &value, sizeof(key));
+			return _mm256_set1_epi32(key);
+		}
+
+		_INLINE static __m256i Equal256(__m256i a, __m256i b) { return _mm256_cmpeq_epi32(a, b); }
+#endif
+	};
+
+	template <>
+	struct FindIntLane<8>
+	{
+		enum { SIMD = true };
+
+		template < class T >
+		_INLINE static __m128i Broadcast(const T& value)
+		{
+			int64 key; memcpy(&key, &value, sizeof(key));
+			return _mm_set1_epi64x(key);
+		}
+
+		// SSE2 has no 64-bit compare, both 32-bit halves must be equal
+		_INLINE static __m128i Equal(__m128i a, __m128i b)
+		{
+			__m128i equal = _mm_cmpeq_epi32(a, b);
+			return _mm_and_si128(equal, _mm_shuffle_epi32(equal, _MM_SHUFFLE(2, 3, 0, 1)));
+		}
+
+#if defined(SIMD_FIND_AVX2)
+		template < class T >
+		_INLINE static __m256i Broadcast256(const T& value)
+		{
+			int64 key; memcpy(&key, &value, sizeof(key));
+			return _mm256_set1_epi64x(key);
+		}
+
+		_INLINE static __m256i Equal256(__m256i a, __m256i b) { return _mm256_cmpeq_epi64(a, b); }
+#endif
+	};
+
+	// Float lanes, compared as floats: NaN is never found and 0.0 finds -0.0, just like operator ==
+	struct FindFloatLane
+	{
+		enum { SIMD = true };
+
+		_INLINE static __m128i Broadcast(float value) { return _mm_castps_si128(_mm_set1_ps(value)); }
+
+		_INLINE static __m128i Equal(__m128i a, __m128i b)
+		{
+			return _mm_castps_si128(_mm_cmpeq_ps(_mm_castsi128_ps(a), _mm_castsi128_ps(b)));
+		}
+
+#if defined(SIMD_FIND_AVX2)
+		_INLINE static __m256i Broadcast256(float value) { return _mm256_castps_si256(_mm256_set1_ps(value)); }
+
+		_INLINE static __m256i Equal256(__m256i a, __m256i b)
+		{
+			return _mm256_castps_si256(_mm256_cmp_ps(_mm256_castsi256_ps(a), _mm256_castsi256_ps(b), _CMP_EQ_OQ));
+		}
+#endif
+	};
+
+	// Double lanes, compared as doubles
+	struct FindDoubleLane
+	{
+		enum { SIMD = true };
+
+		_INLINE static __m128i Broadcast(double value) { return _mm_castpd_si128(_mm_set1_pd(value)); }
+
+		_INLINE static __m128i Equal(__m128i a, __m128i b)
+		{
+			return _mm_castpd_si128(_mm_cmpeq_pd(_mm_castsi128_pd(a), _mm_castsi128_pd(b)));
+		}
+
+#if defined(SIMD_FIND_AVX2)
+		_INLINE static __m256i Broadcast256(double value) { return _mm256_castpd_si256(_mm256_set1_pd(value)); }
+
+		_INLINE static __m256i Equal256(__m256i a, __m256i b)
+		{
+			return _mm256_castpd_si256(_mm256_cmp_pd(_mm256_castsi256_pd(a), _mm256_castsi256_pd(b), _CMP_EQ_OQ));
+		}
+#endif
+	};
+
+	// Arithmetic & pointer keys
+	template <> struct FindLane<char> : FindIntLane<1> {};
+	template <> struct FindLane<signed char> : FindIntLane<1> {};
+	template <> struct FindLane<unsigned char> : FindIntLane<1> {};
+	template <> struct FindLane<short> : FindIntLane<sizeof(short)> {};
+	template <> struct FindLane<unsigned short> : FindIntLane<sizeof(short)> {};
+	template <> struct FindLane<int> : FindIntLane<sizeof(int)> {};
+	template <> struct FindLane<unsigned int> : FindIntLane<sizeof(int)> {};
+	template <> struct FindLane<long> : FindIntLane<sizeof(long)> {};
+	template <> struct FindLane<unsigned long> : FindIntLane<sizeof(long)> {};
+	template <> struct FindLane<long long> : FindIntLane<sizeof(long long)> {};
+	template <> struct FindLane<unsigned long long> : FindIntLane<sizeof(long long)> {};
+	template <> struct FindLane<wchar_t> : FindIntLane<sizeof(wchar_t)> {};
+	template <> struct FindLane<char16_t> : FindIntLane<sizeof(char16_t)> {};
+	template <> struct FindLane<char32_t> : FindIntLane<sizeof(char32_t)> {};
+	template <> struct FindLane<float> : FindFloatLane {};
+	template <> struct FindLane<double> : FindDoubleLane {};
+	template < class T > struct FindLane<T*> : FindIntLane<sizeof(T*)> {};
+	template < class T > struct FindLane<const T> : FindLane<T> {};
+
+	// Find value in data forward, 4 vectors are compared per iteration
+	template < class T >
+	SSIZE_T SimdFind(const T* data, SIZE_T count, const T& value)
+	{
+		typedef FindLane<T> Lane;
+		const ubyte* bytes = (const ubyte*)data;
+		SIZE_T size = count * sizeof(T);
+		SIZE_T offset = 0;
+
+#if defined(SIMD_FIND_AVX2)
+		__m256i key256 = Lane::Broadcast256(value);
+		for (; offset + 128 <= size; offset += 128)
+		{
+			__m256i e0 = Lane::Equal256(_mm256_loadu_si256((const __m256i*)(bytes + offset)), key256);
+			__m256i e1 = Lane::Equal256(_mm256_loadu_si256((const __m256i*)(bytes + offset + 32)), key256);
+			__m256i e2 = Lane::Equal256(_mm256_loadu_si256((const __m256i*)(bytes + offset + 64)), key256);
+			__m256i e3 = Lane::Equal256(_mm256_loadu_si256((const __m256i*)(bytes + offset + 96)), key256);
+			if (_mm256_movemask_epi8(_mm256_or_si256(_mm256_or_si256(e0, e1), _mm256_or_si256(e2, e3))))
+			{
+				uint32 mask;
+				if ((mask = (uint32)_mm256_movemask_epi8(e0)) != 0) return (offset + LowestBit(mask)) / sizeof(T);
+				if ((mask = (uint32)_mm256_movemask_epi8(e1)) != 0) return (offset + 32 + LowestBit(mask)) / sizeof(T);
+				if ((mask = (uint32)_mm256_movemask_epi8(e2)) != 0) return (offset + 64 + LowestBit(mask)) / sizeof(T);
+				mask = (uint32)_mm256_movemask_epi8(e3);
+				return (offset + 96 + LowestBit(mask)) / sizeof(T);
+			}
+		}
+		for (; offset + 32 <= size; offset += 32)
+		{
+			uint32 mask = (uint32)_mm256_movemask_epi8(Lane::Equal256(_mm256_loadu_si256((const __m256i*)(bytes + offset)), key256));
+			if (mask)
+				return (offset + LowestBit(mask)) / sizeof(T);
+		}
+#endif
+
+		__m128i key = Lane::Broadcast(value);
+		for (; offset + 64 <= size; offset += 64)
+		{
+			__m128i e0 = Lane::Equal(_mm_loadu_si128((const __m128i*)(bytes + offset)), key);
+			__m128i e1 = Lane::Equal(_mm_loadu_si128((const __m128i*)(bytes + offset + 16)), key);
+			__m128i e2 = Lane::Equal(_mm_loadu_si128((const __m128i*)(bytes + offset + 32)), key);
+			__m128i e3 = Lane::Equal(_mm_loadu_si128((const __m128i*)(bytes + offset + 48)), key);
+			if (_mm_movemask_epi8(_mm_or_si128(_mm_or_si128(e0, e1), _mm_or_si128(e2, e3))))
+			{
+				uint32 mask;
+				if ((mask = (uint32)_mm_movemask_epi8(e0)) != 0) return (offset + LowestBit(mask)) / sizeof(T);
+				if ((mask = (uint32)_mm_movemask_epi8(e1)) != 0) return (offset + 16 + LowestBit(mask)) / sizeof(T);
+				if ((mask = (uint32)_mm_movemask_epi8(e2)) != 0) return (offset + 32 + LowestBit(mask)) / sizeof(T);
+				mask = (uint32)_mm_movemask_epi8(e3);
+				return (offset + 48 + LowestBit(mask)) / sizeof(T);
+			}
+		}
+		for (; offset + 16 <= size; offset += 16)
+		{
+			uint32 mask = (uint32)_mm_movemask_epi8(Lane::Equal(_mm_loadu_si128((const __m128i*)(bytes + offset)), key));
+			if (mask)
+				return (offset + LowestBit(mask)) / sizeof(T);
+		}
+
+		// Tail, less than a vector
+		for (SIZE_T index = offset / sizeof(T); index < count; index++)
+			if (data[index] == value)
+				return index;
+
+		return INDEX_NONE;
+	}
+
+	// Find value in data backward, 4 vectors are compared per iteration
+	template < class T >
+	SSIZE_T SimdFindLast(const T* data, SIZE_T count, const T& value)
+	{
+		typedef FindLane<T> Lane;
+		const ubyte* bytes = (const ubyte*)data;
+		SIZE_T end = count * sizeof(T);
+
+#if defined(SIMD_FIND_AVX2)
+		__m256i key256 = Lane::Broadcast256(value);
+		for (; end >= 128; end -= 128)
+		{
+			SIZE_T offset = end - 128;
+			__m256i e0 = Lane::Equal256(_mm256_loadu_si256((const __m256i*)(bytes + offset)), key256);
+			__m256i e1 = Lane::Equal256(_mm256_loadu_si256((const __m256i*)(bytes + offset + 32)), key256);
+			__m256i e2 = Lane::Equal256(_mm256_loadu_si256((const __m256i*)(bytes + offset + 64)), key256);
+			__m256i e3 = Lane::Equal256(_mm256_loadu_si256((const __m256i*)(bytes + offset + 96)), key256);
+			if (_mm256_movemask_epi8(_mm256_or_si256(_mm256_or_si256(e0, e1), _mm256_or_si256(e2, e3))))
+			{
+				uint32 mask;
+				if ((mask = (uint32)_mm256_movemask_epi8(e3)) != 0) return (offset + 96 + HighestBit(mask)) / sizeof(T);
+				if ((mask = (uint32)_mm256_movemask_epi8(e2)) != 0) return (offset + 64 + HighestBit(mask)) / sizeof(T);
+				if ((mask = (uint32)_mm256_movemask_epi8(e1)) != 0) return (offset + 32 + HighestBit(mask)) / sizeof(T);
+				mask = (uint32)_mm256_movemask_epi8(e0);
+				return (offset + HighestBit(mask)) / sizeof(T);
+			}
+		}
+		for (; end >= 32; end -= 32)
+		{
+			uint32 mask = (uint32)_mm256_movemask_epi8(Lane::Equal256(_mm256_loadu_si256((const __m256i*)(bytes + end - 32)), key256));
+			if (mask)
+				return (end - 32 + HighestBit(mask)) / sizeof(T);
+		}
+#endif
+
+		__m128i key = Lane::Broadcast(value);
+		for (; end >= 64; end -= 64)
+		{
+			SIZE_T offset = end - 64;
+			__m128i e0 = Lane::Equal(_mm_loadu_si128((const __m128i*)(bytes + offset)), key);
+			__m128i e1 = Lane::Equal(_mm_loadu_si128((const __m128i*)(bytes + offset + 16)), key);
+			__m128i e2 = Lane::Equal(_mm_loadu_si128((const __m128i*)(bytes + offset + 32)), key);
+			__m128i e3 = Lane::Equal(_mm_loadu_si128((const __m128i*)(bytes + offset + 48)), key);
+			if (_mm_movemask_epi8(_mm_or_si128(_mm_or_si128(e0, e1), _mm_or_si128(e2, e3))))
+			{
+				uint32 mask;
+				if ((mask = (uint32)_mm_movemask_epi8(e3)) != 0) return (offset + 48 + HighestBit(mask)) / sizeof(T);
+				if ((mask = (uint32)_mm_movemask_epi8(e2)) != 0) return (offset + 32 + HighestBit(mask)) / sizeof(T);
+				if ((mask = (uint32)_mm_movemask_epi8(e1)) != 0) return (offset + 16 + HighestBit(mask)) / sizeof(T);
+				mask = (uint32)_mm_movemask_epi8(e0);
+				return (offset + HighestBit(mask)) / sizeof(T);
+			}
+		}
+		for (; end >= 16; end -= 16)
+		{
+			uint32 mask = (uint32)_mm_movemask_epi8(Lane::Equal(_mm_loadu_si128((const __m128i*)(bytes + end - 16)), key));
+			if (mask)
+				return (end - 16 + HighestBit(mask)) / sizeof(T);
+		}
+
+		// Head, less than a vector
+		for (SIZE_T index = end / sizeof(T); index-- > 0; )
+			if (data[index] == value)
+				return index;
+
+		return INDEX_NONE;
+	}
+
+#endif // SIMD_FIND_SSE2
+
+	// Find value in elements compared by operator ==
+	template < class T >
+	SSIZE_T ScalarFind(const T* data, SIZE_T count, const T& value)
+	{
+		for (SIZE_T index = 0; index < count; index++)
+			if (value == data[index])
+				return index;
+
+		return INDEX_NONE;
+	}
+
+	// Find value in elements backward, compared by operator ==
+	template < class T >
+	SSIZE_T ScalarFindLast(const T* data, SIZE_T count, const T& value)
+	{
+		for (SIZE_T index = count; index-- > 0; )
+			if (value == data[index])
+				return index;
+
+		return INDEX_NONE;
+	}
+
+	// Select SIMD or scalar find for a key type at compile time
+	template < class T, bool SIMD = FindLane<T>::SIMD >
+	struct FindDispatch
+	{
+		_INLINE static SSIZE_T Find(const T* data, SIZE_T count, const T& value) { return ScalarFind(data, count, value); }
+		_INLINE static SSIZE_T FindLast(const T* data, SIZE_T count, const T& value) { return ScalarFindLast(data, count, value); }
+	};
+
+#if defined(SIMD_FIND_SSE2)
+	template < class T >
+	struct FindDispatch<T, true>
+	{
+		_INLINE static SSIZE_T Find(const T* data, SIZE_T count, const T& value) { return SimdFind(data, count, value); }
+		_INLINE static SSIZE_T FindLast(const T* data, SIZE_T count, const T& value) { return SimdFindLast(data, count, value); }
+	};
+#endif
+
+	// Find the first element equal to value,
+	// integer, float & pointer elements are compared by SSE2/AVX2 vectors, other types by operator ==
+	//
+	// @param: data - first element
+	// @param: count - count of elements
+	// @param: value - value to find
+	// @return: index of the first element equal to value, INDEX_NONE if not found
+	template < class T >
+	_INLINE SSIZE_T FindIndex(const T* data, SIZE_T count, const T& value)
+	{
+		return FindDispatch<T>::Find(data, count, value);
+	}
+
+	// Find the last element equal to value,
+	// integer, float & pointer elements are compared by SSE2/AVX2 vectors, other types by operator ==
+	//
+	// @param: data - first element
+	// @param: count - count of elements
+	// @param: value - value to find
+	// @return: index of the last element equal to value, INDEX_NONE if not found
+	template < class T >
+	_INLINE SSIZE_T FindLastIndex(const T* data, SIZE_T count, const T& value)
+	{
+		return FindDispatch<T>::FindLast(data, count, value);
+	}
+}
@@ -0,0 +1,305 @@
+/*****************************************************************************
+The MIT License(MIT)
+
+Copyright(c) 2016 Amr Esam
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*********************************************************************************/
+#pragma once
+
+#include "../system.h"
+#include "../Template/Common.h"
+#include "../Template/Compare.h"
+#include "../containers/ArrayView.h"
+#include "ThreadPool.h"
+#include "Sort.h"
+
+/* For partial results of ParallelReduce */
+#include <vector>
+
+namespace Everest
+{
+	// Ranges up to this count are not split between threads
+	enum { PARALLEL_MIN_GRAIN = 4096 };
+
+	// Ranges up to this count are sorted in one task
+	enum { PARALLEL_SORT_CUTOFF = 1 << 15 };
+
+	// Chunks per thread, more chunks balance uneven work between threads
+	enum { PARALLEL_CHUNKS_PER_THREAD = 4 };
+
+	// Call function(start, end) for chunks of [0, count) on pool threads, returns when all chunks are done
+	//
+	// @param: count - Count of elements
+	// @param: function - Function called for each chunk with its start and end indices
+	// @param: grain(PARALLEL_MIN_GRAIN) - Minimum chunk size
+	// @param: pool(default pool) - Thread pool to run on
+	template < class Function >
+	void ParallelFor(SIZE_T count, Function function, SIZE_T grain = PARALLEL_MIN_GRAIN,
+		ThreadPool& pool = ThreadPool::GetDefault())
+	{
+		SIZE_T chunks = pool.GetThreadCount() * PARALLEL_CHUNKS_PER_THREAD;
+		SIZE_T chunk = (count + chunks - 1) / chunks;
+		if (chunk < grain)
+			chunk = grain;
+
+		if (count <= chunk)
+		{
+			function((SIZE_T)0, count);
+			return;
+		}
+
+		TaskGroup group;
+		SIZE_T start = 0;
+		for (; start + chunk < count; start += chunk)
+			pool.Run(group, [start, chunk, &function]() { function(start, start + chunk); });
+
+		// The last chunk runs on this thread
+		function(start, count);
+
+		pool.Wait(group);
+	}
+
+	// Parallel introsort task, partitions and queues the left part until parts are small enough
+	template < class T, class Compare >
+	void ParallelSortTask(T* first, T* last, uint32 depth, Compare less, ThreadPool& pool, TaskGroup& group)
+	{
+		while (last - first > PARALLEL_SORT_CUTOFF)
+		{
+			if (depth-- == 0)
+			{
+				HeapSort(first, last, less);
+				return;
+			}
+
+			T* cut = Partition(first, last, less);
+
+			T* left = first;
+			pool.Run(group, [left, cut, depth, less, &pool, &group]()
+			{
+				ParallelSortTask(left, cut, depth, less, pool, group);
+			});
+
+			first = cut;
+		}
+
+		IntroSort(first, last, depth, less);
+	}
+
+	// Sort a range on pool threads, parallel introsort
+	// Sort is not stable
+	//
+	// @param: first - first element of the range
+	// @param: last - one past the last element of the range
+	// @param: less - Compare function, true if first argument is ordered before second
+	// @param: pool(default pool) - Thread pool to run on
+	template < class T, class Compare >
+	void ParallelSort(T* first, T* last, Compare less, ThreadPool& pool = ThreadPool::GetDefault())
+	{
+		if (last - first <= PARALLEL_SORT_CUTOFF)
+		{
+			Sort(first, last, less);
+			return;
+		}
+
+		TaskGroup group;
+		ParallelSortTask(first, last, SortDepthLimit(last - first), less, pool, group);
+		pool.Wait(group);
+	}
+
+	// Sort a range on pool threads in ascending order
+	template < class T >
+	_INLINE void ParallelSort(T* first, T* last)
+	{
+		ParallelSort(first, last, Less<T>());
+	}
+
+	// Sort a range of an iterators on pool threads
+	template < class T, class Compare >
+	_INLINE void ParallelSort(linearIterator<T> first, linearIterator<T> last, Compare less,
+		ThreadPool& pool = ThreadPool::GetDefault())
+	{
+		ParallelSort(first.operator->(), last.operator->(), less, pool);
+	}
+
+	// Sort a range of an iterators on pool threads in ascending order
+	template < class T >
+	_INLINE void ParallelSort(linearIterator<T> first, linearIterator<T> last)
+	{
+		ParallelSort(first.operator->(), last.operator->(), Less<T>());
+	}
+
+	// Sort all array elements on pool threads
+	template < class T, class Allocator, class Compare >
+	_INLINE void ParallelSort(Array<T, Allocator>& array, Compare less, ThreadPool& pool = ThreadPool::GetDefault())
+	{
+		ParallelSort(array.Data(), array.Data() + array.Size(), less, pool);
+	}
+
+	// Sort all array elements on pool threads in ascending order
+	template < class T, class Allocator >
+	_INLINE void ParallelSort(Array<T, Allocator>& array)
+	{
+		ParallelSort(array.Data(), array.Data() + array.Size(), Less<T>());
+	}
+
+	// Sort all view elements on pool threads
+	template < class T, class Compare >
+	_INLINE void ParallelSort(ArrayView<T> view, Compare less, ThreadPool& pool = ThreadPool::GetDefault())
+	{
+		ParallelSort(view.Data(), view.Data() + view.Size(), less, pool);
+	}
+
+	// Sort all view elements on pool threads in ascending order
+	template < class T >
+	_INLINE void ParallelSort(ArrayView<T> view)
+	{
+		ParallelSort(view.Data(), view.Data() + view.Size(), Less<T>());
+	}
+
+	// Reduce a range to one value on pool threads, each chunk is reduced then chunk results are reduced in order
+	//
+	// @param: first - first element of the range
+	// @param: last - one past the last element of the range
+	// @param: init - Initial value
+	// @param: operation - Associative function that combines two values, T(const T&, const T&)
+	// @param: pool(default pool) - Thread pool to run on
+	// @return: init combined with all range elements
+	template < class T, class Operation >
+	T ParallelReduce(const T* first, const T* last, T init, Operation operation,
+		ThreadPool& pool = ThreadPool::GetDefault())
+	{
+		SIZE_T count = last - first;
+		SIZE_T chunks = count / PARALLEL_MIN_GRAIN;
+		if (chunks > pool.GetThreadCount() * PARALLEL_CHUNKS_PER_THREAD)
+			chunks = pool.GetThreadCount() * PARALLEL_CHUNKS_PER_THREAD;
+
+		if (chunks <= 1)
+		{
+			for (; first < last; ++first)
+				init = operation(init, *first);
+			return init;
+		}
+
+		// Each chunk result starts from the chunk first element
+		SIZE_T chunk = (count + chunks - 1) / chunks;
+		std::vector<T> partials;
+		partials.reserve(chunks);
+		for (SIZE_T start = 0; start < count; start += chunk)
+			partials.push_back(first[start]);
+
+		TaskGroup group;
+		for (SIZE_T i = 1; i < partials.size(); i++)
+		{
+			pool.Run(group, [i, chunk, count, first, &partials, &operation]()
+			{
+				SIZE_T end = (i + 1) * chunk < count ? (i + 1) * chunk : count;
+				for (SIZE_T index = i * chunk + 1; index < end; index++)
+					partials[i] = operation(partials[i], first[index]);
+			});
+		}
+
+		// The first chunk runs on this thread
+		for (SIZE_T index = 1; index < chunk; index++)
+			partials[0] = operation(partials[0], first[index]);
+
+		pool.Wait(group);
+
+		for (const T& partial : partials)
+			init = operation(init, partial);
+
+		return init;
+	}
+
+	// Reduce a range of an iterators to one value on pool threads
+	template < class T, class Operation >
+	_INLINE T ParallelReduce(linearIterator<T> first, linearIterator<T> last, T init, Operation operation,
+		ThreadPool& pool = ThreadPool::GetDefault())
+	{
+		return ParallelReduce((const T*)first.operator->(), (const T*)last.operator->(), init, operation, pool);
+	}
+
+	// Reduce all array elements to one value on pool threads
+	template < class T, class Allocator, class Operation >
+	_INLINE T ParallelReduce(const Array<T, Allocator>& array, T init, Operation operation,
+		ThreadPool& pool = ThreadPool::GetDefault())
+	{
+		return ParallelReduce(array.Data(), array.Data() + array.Size(), init, operation, pool);
+	}
+
+	// Reduce all view elements to one value on pool threads
+	template < class T, class Operation >
+	_INLINE T ParallelReduce(ArrayView<T> view, T init, Operation operation,
+		ThreadPool& pool = ThreadPool::GetDefault())
+	{
+		return ParallelReduce((const T*)view.Data(), (const T*)view.Data() + view.Size(), init, operation, pool);
+	}
+
+	// Reduce all read only view elements to one value on pool threads
+	template < class T, class Operation >
+	_INLINE T ParallelReduce(ArrayView<const T> view, T init, Operation operation,
+		ThreadPool& pool = ThreadPool::GetDefault())
+	{
+		return ParallelReduce(view.Data(), view.Data() + view.Size(), init, operation, pool);
+	}
+
+	// Transform a range into dest on pool threads, dest[i] = operation(first[i])
+	// dest elements are assigned, so they must be constructed, dest may be the source range
+	//
+	// @param: first - first element of the range
+	// @param: last - one past the last element of the range
+	// @param: dest - first element of the destination range
+	// @param: operation - Function that returns the transformed value, U(const T&)
+	// @param: pool(default pool) - Thread pool to run on
+	template < class T, class U, class Operation >
+	void ParallelTransform(const T* first, const T* last, U* dest, Operation operation,
+		ThreadPool& pool = ThreadPool::GetDefault())
+	{
+		ParallelFor(last - first, [first, dest, &operation](SIZE_T start, SIZE_T end)
+		{
+			for (; start < end; start++)
+				dest[start] = operation(first[start]);
+		}, PARALLEL_MIN_GRAIN, pool);
+	}
+
+	// Transform a range of an iterators into dest on pool threads
+	template < class T, class U, class Operation >
+	_INLINE void ParallelTransform(linearIterator<T> first, linearIterator<T> last, linearIterator<U> dest,
+		Operation operation, ThreadPool& pool = ThreadPool::GetDefault())
+	{
+		ParallelTransform((const T*)first.operator->(), (const T*)last.operator->(), dest.operator->(), operation, pool);
+	}
+
+	// Transform all array elements in place on pool threads
+	template < class T, class Allocator, class Operation >
+	_INLINE void ParallelTransform(Array<T, Allocator>& array, Operation operation,
+		ThreadPool& pool = ThreadPool::GetDefault())
+	{
+		ParallelTransform((const T*)array.Data(), (const T*)array.Data() + array.Size(), array.Data(), operation, pool);
+	}
+
+	// Transform all view elements in place on pool threads
+	template < class T, class Operation >
+	_INLINE void ParallelTransform(ArrayView<T> view, Operation operation,
+		ThreadPool& pool = ThreadPool::GetDefault())
+	{
+		ParallelTransform((const T*)view.Data(), (const T*)view.Data() + view.Size(), view.Data(), operation, pool);
+	}
+}
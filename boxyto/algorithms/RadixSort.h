@@ -0,0 +1,193 @@
+/*****************************************************************************
+The MIT License(MIT)
+
+Copyright(c) 2016 Amr Esam
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*********************************************************************************/
+#pragma once
+
+#include "../system.h"
+#include "../Template/Common.h"
+#include "../memory/StaticSegment.h"
+#include "../containers/ArrayView.h"
+#include "../containers/Pair.h"
+
+/* For relocating elements and reading float bits */
+#include <cstring>
+
+namespace Everest
+{
+	// Radix key of an element, an unsigned integer with the same order as the element,
+	// defined for integer & float elements, and for Pairs of them keyed on first
+	template < class T >
+	struct RadixKey;
+
+	// Unsigned integers are their own keys
+	template < class T, class KeyType >
+	struct RadixUnsignedKey
+	{
+		typedef KeyType Key;
+		_INLINE static Key Get(T value) { return (Key)value; }
+	};
+
+	// Signed integers keys, flip the sign bit so negative values are ordered first
+	template < class T, class KeyType >
+	struct RadixSignedKey
+	{
+		typedef KeyType Key;
+		_INLINE static Key Get(T value) { return (Key)value ^ ((Key)1 << (sizeof(Key) * 8 - 1)); }
+	};
+
+	// Floats keys, flip all bits of negative values & the sign bit of positive values,
+	// negative values are ordered first, then positive ones, -0.0 is ordered before 0.0
+	template < class T, class KeyType >
+	struct RadixFloatKey
+	{
+		typedef KeyType Key;
+		_INLINE static Key Get(T value)
+		{
+			Key bits;
+			memcpy(&bits, &value, sizeof(bits));
+			Key sign = (Key)1 << (sizeof(Key) * 8 - 1);
+			return (bits & sign) ? ~bits : (bits | sign);
+		}
+	};
+
+	template <> struct RadixKey<unsigned char> : RadixUnsignedKey<unsigned char, uint8> {};
+	template <> struct RadixKey<unsigned short> : RadixUnsignedKey<unsigned short, uint16> {};
+	template <> struct RadixKey<unsigned int> : RadixUnsignedKey<unsigned int, uint32> {};
+	template <> struct RadixKey<unsigned long> : RadixUnsignedKey<unsigned long, SelectType<sizeof(long) == 8, uint64, uint32>::Type> {};
+	template <> struct RadixKey<unsigned long long> : RadixUnsignedKey<unsigned long long, uint64> {};
+	template <> struct RadixKey<signed char> : RadixSignedKey<signed char, uint8> {};
+	template <> struct RadixKey<char> : SelectType<(char)-1 < 0, RadixSignedKey<char, uint8>, RadixUnsignedKey<char, uint8>>::Type {};
+	template <> struct RadixKey<short> : RadixSignedKey<short, uint16> {};
+	template <> struct RadixKey<int> : RadixSignedKey<int, uint32> {};
+	template <> struct RadixKey<long> : RadixSignedKey<long, SelectType<sizeof(long) == 8, uint64, uint32>::Type> {};
+	template <> struct RadixKey<long long> : RadixSignedKey<long long, uint64> {};
+	template <> struct RadixKey<float> : RadixFloatKey<float, uint32> {};
+	template <> struct RadixKey<double> : RadixFloatKey<double, uint64> {};
+
+	// Pairs are keyed on first
+	template < class K, class V >
+	struct RadixKey<Pair<K, V>>
+	{
+		typedef typename RadixKey<K>::Key Key;
+		_INLINE static Key Get(const Pair<K, V>& pair) { return RadixKey<K>::Get(pair._first); }
+	};
+
+	// Radix sort digit, 8 bits, 256 buckets
+	enum { RADIX_BITS = 8, RADIX_BUCKETS = 1 << RADIX_BITS };
+
+	// Sort a range by LSD radix sort, a stable O(n) sort for integer & float keys
+	// One pass per key byte, passes where all keys have the same byte are skipped,
+	// elements are relocated by memory copy between the range and a scratch buffer, just like Array elements
+	//
+	// @param: data - first element of the range
+	// @param: count - count of elements
+	// @param: scratch - Segment to allocate a scratch buffer of count elements from, it is rewound when done
+	// @return: false if scratch has not enough memory, the range is not sorted
+	template < class T >
+	bool RadixSort(T* data, SIZE_T count, StaticSegment& scratch)
+	{
+		typedef RadixKey<T> Traits;
+		typedef typename Traits::Key Key;
+		enum { PASSES = sizeof(Key) };
+
+		if (count < 2)
+			return true;
+
+		// Histogram of all passes in one read of the keys
+		SIZE_T histogram[PASSES][RADIX_BUCKETS];
+		memset(histogram, 0, sizeof(histogram));
+		for (SIZE_T i = 0; i < count; i++)
+		{
+			Key key = Traits::Get(data[i]);
+			for (uint32 pass = 0; pass < PASSES; pass++)
+				histogram[pass][(key >> (pass * RADIX_BITS)) & (RADIX_BUCKETS - 1)]++;
+		}
+
+		SIZE_T mark = scratch.Mark();
+		T* buffer = (T*)scratch.Alloc(sizeof(T) * count, alignof(T));
+		if (!buffer)
+			return false; // LOG: OUT OF MEMORY
+
+		T* source = data;
+		T* dest = buffer;
+		for (uint32 pass = 0; pass < PASSES; pass++)
+		{
+			SIZE_T* buckets = histogram[pass];
+			uint32 shift = pass * RADIX_BITS;
+
+			// All keys have the same digit, order does not change
+			if (buckets[(Traits::Get(source[0]) >> shift) & (RADIX_BUCKETS - 1)] == count)
+				continue;
+
+			// Buckets counts to start offsets
+			SIZE_T offset = 0;
+			for (uint32 bucket = 0; bucket < RADIX_BUCKETS; bucket++)
+			{
+				SIZE_T bucketCount = buckets[bucket];
+				buckets[bucket] = offset;
+				offset += bucketCount;
+			}
+
+			// Scatter in order, keeps equal keys order
+			for (SIZE_T i = 0; i < count; i++)
+			{
+				SIZE_T& position = buckets[(Traits::Get(source[i]) >> shift) & (RADIX_BUCKETS - 1)];
+				memcpy((void*)(dest + position++), (const void*)(source + i), sizeof(T));
+			}
+
+			T* temp = source;
+			source = dest;
+			dest = temp;
+		}
+
+		// Sorted elements are in the scratch buffer after odd count of passes
+		if (source != data)
+			Memcopy(data, source, sizeof(T) * count);
+
+		scratch.Rewind(mark);
+		return true;
+	}
+
+	// Sort all array elements by LSD radix sort, a stable O(n) sort for integer & float keys
+	//
+	// @param: array - Array of integers, floats or Pairs keyed on them
+	// @param: scratch - Segment to allocate a scratch buffer from, it is rewound when done
+	// @return: false if scratch has not enough memory, the array is not sorted
+	template < class T, class Allocator >
+	_INLINE bool RadixSort(Array<T, Allocator>& array, StaticSegment& scratch)
+	{
+		return RadixSort(array.Data(), array.Size(), scratch);
+	}
+
+	// Sort all view elements by LSD radix sort, sorts a slice of an array in place
+	//
+	// @param: view - View of integers, floats or Pairs keyed on them
+	// @param: scratch - Segment to allocate a scratch buffer from, it is rewound when done
+	// @return: false if scratch has not enough memory, the view is not sorted
+	template < class T >
+	_INLINE bool RadixSort(ArrayView<T> view, StaticSegment& scratch)
+	{
+		return RadixSort(view.Data(), view.Size(), scratch);
+	}
+}
@@ -0,0 +1,233 @@
+/*****************************************************************************
+The MIT License(MIT)
+
+Copyright(c) 2016 Amr Esam
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*********************************************************************************/
+#pragma once
+
+#include "../system.h"
+#include "../Template/Common.h"
+#include "../Template/Compare.h"
+#include "../containers/ArrayView.h"
+
+namespace Everest
+{
+	// Ranges up to this count are sorted by insertion sort
+	enum { SORT_INSERTION_THRESHOLD = 16 };
+
+	// Sort a small range by insertion sort
+	//
+	// @param: first - first element of the range
+	// @param: last - one past the last element of the range
+	// @param: less - Compare function, true if first argument is ordered before second
+	template < class T, class Compare >
+	void InsertionSort(T* first, T* last, Compare less)
+	{
+		for (T* current = first + 1; current < last; ++current)
+		{
+			T value = _EVEREST Move(*current);
+			T* hole = current;
+			for (; hole > first && less(value, *(hole - 1)); --hole)
+				*hole = _EVEREST Move(*(hole - 1));
+			*hole = _EVEREST Move(value);
+		}
+	}
+
+	// Move value down the heap at root, until its children are ordered before it
+	template < class T, class Compare >
+	void SiftDown(T* heap, SSIZE_T root, SSIZE_T count, Compare less)
+	{
+		T value = _EVEREST Move(heap[root]);
+		for (SSIZE_T child = root * 2 + 1; child < count; child = root * 2 + 1)
+		{
+			if (child + 1 < count && less(heap[child], heap[child + 1]))
+				child++;
+			if (!less(value, heap[child]))
+				break;
+
+			heap[root] = _EVEREST Move(heap[child]);
+			root = child;
+		}
+		heap[root] = _EVEREST Move(value);
+	}
+
+	// Sort a range by heap sort, O(n log n) worst case
+	//
+	// @param: first - first element of the range
+	// @param: last - one past the last element of the range
+	// @param: less - Compare function, true if first argument is ordered before second
+	template < class T, class Compare >
+	void HeapSort(T* first, T* last, Compare less)
+	{
+		SSIZE_T count = last - first;
+		for (SSIZE_T root = count / 2 - 1; root >= 0; root--)
+			SiftDown(first, root, count, less);
+
+		while (--count > 0)
+		{
+			T value = _EVEREST Move(first[count]);
+			first[count] = _EVEREST Move(first[0]);
+			first[0] = _EVEREST Move(value);
+			SiftDown(first, 0, count, less);
+		}
+	}
+
+	// Partition a range around the median of first, middle and last elements
+	// Elements before the returned cut are not ordered after the pivot, elements from the cut are not ordered before it
+	//
+	// @param: first - first element of the range, the range has more than 3 elements
+	// @param: last - one past the last element of the range
+	// @param: less - Compare function
+	// @return: The partition cut
+	template < class T, class Compare >
+	T* Partition(T* first, T* last, Compare less)
+	{
+		T* middle = first + (last - first) / 2;
+
+		// Order first, middle and last, the median is at middle
+		if (less(*middle, *first))
+			_EVEREST Swap(*middle, *first);
+		if (less(*(last - 1), *middle))
+		{
+			_EVEREST Swap(*(last - 1), *middle);
+			if (less(*middle, *first))
+				_EVEREST Swap(*middle, *first);
+		}
+
+		T pivot = *middle;
+
+		// Hoare partition, first and last elements are sentinels
+		T* left = first;
+		T* right = last - 1;
+		for (;;)
+		{
+			do ++left; while (less(*left, pivot));
+			do --right; while (less(pivot, *right));
+
+			if (left >= right)
+				return right + 1;
+
+			_EVEREST Swap(*left, *right);
+		}
+	}
+
+	// Return the introsort depth limit for count of elements, 2 * log2(count)
+	_INLINE uint32 SortDepthLimit(SIZE_T count)
+	{
+		uint32 depth = 0;
+		for (; count > 1; count >>= 1)
+			depth += 2;
+		return depth;
+	}
+
+	// Introsort loop, quick sort until depth limit, then heap sort
+	template < class T, class Compare >
+	void IntroSort(T* first, T* last, uint32 depth, Compare less)
+	{
+		while (last - first > SORT_INSERTION_THRESHOLD)
+		{
+			if (depth-- == 0)
+			{
+				HeapSort(first, last, less);
+				return;
+			}
+
+			T* cut = Partition(first, last, less);
+
+			// Recurse into the smaller part, loop on the bigger one
+			if (cut - first < last - cut)
+			{
+				IntroSort(first, cut, depth, less);
+				first = cut;
+			}
+			else
+			{
+				IntroSort(cut, last, depth, less);
+				last = cut;
+			}
+		}
+
+		InsertionSort(first, last, less);
+	}
+
+	// Sort a range, introsort: quick sort, heap sort if quick sort goes too deep, insertion sort for small ranges
+	// Sort is not stable
+	//
+	// @param: first - first element of the range
+	// @param: last - one past the last element of the range
+	// @param: less - Compare function, true if first argument is ordered before second
+	template < class T, class Compare >
+	_INLINE void Sort(T* first, T* last, Compare less)
+	{
+		if (last - first > 1)
+			IntroSort(first, last, SortDepthLimit(last - first), less);
+	}
+
+	// Sort a range in ascending order
+	template < class T >
+	_INLINE void Sort(T* first, T* last)
+	{
+		Sort(first, last, Less<T>());
+	}
+
+	// Sort a range of an iterators
+	template < class T, class Compare >
+	_INLINE void Sort(linearIterator<T> first, linearIterator<T> last, Compare less)
+	{
+		Sort(first.operator->(), last.operator->(), less);
+	}
+
+	// Sort a range of an iterators in ascending order
+	template < class T >
+	_INLINE void Sort(linearIterator<T> first, linearIterator<T> last)
+	{
+		Sort(first.operator->(), last.operator->(), Less<T>());
+	}
+
+	// Sort all array elements
+	template < class T, class Allocator, class Compare >
+	_INLINE void Sort(Array<T, Allocator>& array, Compare less)
+	{
+		Sort(array.Data(), array.Data() + array.Size(), less);
+	}
+
+	// Sort all array elements in ascending order
+	template < class T, class Allocator >
+	_INLINE void Sort(Array<T, Allocator>& array)
+	{
+		Sort(array.Data(), array.Data() + array.Size(), Less<T>());
+	}
+
+	// Sort all view elements, sorts a slice of an array in place
+	template < class T, class Compare >
+	_INLINE void Sort(ArrayView<T> view, Compare less)
+	{
+		Sort(view.Data(), view.Data() + view.Size(), less);
+	}
+
+	// Sort all view elements in ascending order
+	template < class T >
+	_INLINE void Sort(ArrayView<T> view)
+	{
+		Sort(view.Data(), view.Data() + view.Size(), Less<T>());
+	}
+}
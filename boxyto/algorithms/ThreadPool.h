@@ -0,0 +1,215 @@
+/*****************************************************************************
+The MIT License(MIT)
+
+Copyright(c) 2016 Amr Esam
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*********************************************************************************/
+#pragma once
+
+#include "../system.h"
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <deque>
+#include <vector>
+
+namespace Everest
+{
+	// A group of tasks run by ThreadPool, waiting on a group returns when all its tasks finished
+	class TaskGroup
+	{
+		friend class ThreadPool;
+
+	public:
+
+		TaskGroup() :
+			pending(0)
+		{}
+
+		// Delete copy constructor
+		TaskGroup(const TaskGroup&) = delete;
+		TaskGroup& operator= (const TaskGroup&) = delete;
+
+		// Return count of tasks not finished yet
+		_INLINE uint32 Pending() const
+		{
+			return pending;
+		}
+
+	private:
+
+		// Count of tasks not finished yet, guarded by the pool mutex
+		uint32 pending;
+	};
+
+   /*
+	* ThreadPool Class, fixed count of worker threads running queued tasks.
+	*
+	* Tasks are run in groups, a thread that waits on a group runs queued tasks until
+	* the group is done, so tasks can run and wait on nested tasks (fork-join) with no deadlock.
+	* Tasks are taken last in first out, nested tasks run first, while their data is still in cache.
+	*/
+	class ThreadPool
+	{
+	public:
+
+		// Create a pool of worker threads
+		//
+		// @param: threadCount(0) - Count of worker threads, 0 to use one less than hardware threads,
+		//                          the thread waiting on a group is the other one
+		ThreadPool(uint32 threadCount = 0) :
+			stop(false)
+		{
+			if (threadCount == 0)
+			{
+				uint32 hardware = std::thread::hardware_concurrency();
+				threadCount = hardware > 1 ? hardware - 1 : 1;
+			}
+
+			workers.reserve(threadCount);
+			for (uint32 i = 0; i < threadCount; i++)
+				workers.emplace_back(&ThreadPool::WorkerLoop, this);
+		}
+
+		// Delete copy constructor
+		ThreadPool(const ThreadPool&) = delete;
+		ThreadPool& operator= (const ThreadPool&) = delete;
+
+		// Destructor, queued tasks are finished before workers exit
+		~ThreadPool()
+		{
+			{
+				std::unique_lock<std::mutex> lock(mutex);
+				stop = true;
+			}
+			taskReady.notify_all();
+
+			for (std::thread& worker : workers)
+				worker.join();
+		}
+
+		// Queue a task to run in group
+		//
+		// @param: group - The group of the task
+		// @param: task - The task function
+		void Run(TaskGroup& group, std::function<void()> task)
+		{
+			{
+				std::unique_lock<std::mutex> lock(mutex);
+				group.pending++;
+				tasks.push_back(Task{ _EVEREST Move(task), &group });
+			}
+			taskReady.notify_one();
+		}
+
+		// Wait all group tasks to finish, running queued tasks while waiting
+		//
+		// @param: group - The group to wait for
+		void Wait(TaskGroup& group)
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			while (group.pending)
+			{
+				if (!tasks.empty())
+					RunOne(lock);
+				else
+					taskDone.wait(lock);
+			}
+		}
+
+		// Return count of threads running tasks, workers and the waiting thread
+		_INLINE uint32 GetThreadCount() const
+		{
+			return (uint32)workers.size() + 1;
+		}
+
+		// Return the default pool, created on first use with one worker less than hardware threads
+		static ThreadPool& GetDefault()
+		{
+			static ThreadPool pool;
+			return pool;
+		}
+
+	private:
+
+		// A queued task
+		struct Task
+		{
+			std::function<void()> function;
+			TaskGroup* group;
+		};
+
+		// Run the last queued task, lock is released while the task runs
+		//
+		// @param: lock - Locked pool mutex
+		void RunOne(std::unique_lock<std::mutex>& lock)
+		{
+			Task task = _EVEREST Move(tasks.back());
+			tasks.pop_back();
+
+			lock.unlock();
+			task.function();
+			lock.lock();
+
+			// Wake waiting threads, the finished task may be the last in its group
+			if (--task.group->pending == 0)
+				taskDone.notify_all();
+		}
+
+		// Worker thread function
+		void WorkerLoop()
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			for (;;)
+			{
+				if (!tasks.empty())
+					RunOne(lock);
+				else if (stop)
+					return;
+				else
+					taskReady.wait(lock);
+			}
+		}
+
+	private:
+
+		// Worker threads
+		std::vector<std::thread> workers;
+
+		// Queued tasks
+		std::deque<Task> tasks;
+
+		// Guards tasks, groups pending count and stop
+		std::mutex mutex;
+
+		// Signaled when a task queued or the pool stops
+		std::condition_variable taskReady;
+
+		// Signaled when a group finished
+		std::condition_variable taskDone;
+
+		// True when the pool is destructing
+		bool stop;
+
+	}; // ThreadPool
+}
@@ -28,6 +28,10 @@ SOFTWARE.
 #include "../system.h"
 #include "../Template/Common.h"
 #include "../memory/MemoryOps.h"
+#include "../algorithms/Find.h"
+
+/* For std::iterator_traits & std::distance */
+#include <iterator>
 
 namespace Everest
 {
@@ -67,7 +71,7 @@ namespace Everest
 
 		_MyT operator--(int junk)
 		{
-			_ptr--; _index-- return *this;
+			_ptr--; _index--; return *this;
 		}
 
 		reference operator*()
@@ -174,7 +178,7 @@ namespace Everest
 
 		_MyT operator--(int junk)
 		{
-			_ptr++; _index++ return *this;
+			_ptr++; _index++; return *this;
 		}
 
 		reference operator*()
@@ -258,6 +262,10 @@ namespace Everest
 	*
 	* @author: Amr Esam
 	*/
+	// Non owning view of contiguous elements, see ArrayView.h
+	template < class T >
+	class ArrayView;
+
 	template < class T, class AllocatorType >
 	class Array
 	{
@@ -273,7 +281,7 @@ public:
 		typedef ElementType&& rvalue;
 		typedef const ElementType& const_reference;
 
-		typedef typename AllocatorType Allocator;
+		typedef AllocatorType Allocator;
 
 		typedef linearIterator < ElementType > iterator;
 		typedef linearIterator <const ElementType > const_iterator;
@@ -297,12 +305,12 @@ public:
 		//
 		// @param: other - Array to copy from
 		Array(Array& other) :
-			_capacity(other.Capacity()),
+			_capacity(0),
 			_size(0),
 			_allocator(other.GetAllocator())
 		{
 			_allocator.Init();
-			_allocator.Allocate(_capacity);
+			Reserve(other.Capacity());
 
 			// Copy from other to this array
 			Append(other);
@@ -313,12 +321,12 @@ public:
 		// @param: other - Array to copy from
 		// @param: capacity - the initial capacity to add at the end of the array
 		Array(const uint32 capacity, Allocator alloc) :
-			_capacity(capacity),
+			_capacity(0),
 			_size(0),
 			_allocator(alloc)
 		{
 			_allocator.Init();
-			_allocator.Allocate(_capacity);
+			Reserve(capacity);
 		}
 
 		// Destruct all items and free allocation
@@ -344,6 +352,8 @@ public:
 		int32 Emplace(Args&&... args)
 		{
 			const int32 index = AddUninitialized();
+			if (index == INDEX_NONE)
+				return INDEX_NONE; // LOG: OUT OF MEMORY
 			new(Data() + index)
 				ElementType(_EVEREST Forward <Args>(args)...);
 			return index;
@@ -381,6 +391,8 @@ public:
 
 			// Add uninitialize elements
 			int32 index = AddUninitialized(other.Size());
+			if (index == INDEX_NONE)
+				return INDEX_NONE; // LOG: OUT OF MEMORY
 
 			// Construct from other array
 			ConstructRangeFromRange(other.Data(), Data(), other.Size(), index);
@@ -388,11 +400,74 @@ public:
 			return index;
 		}
 
+		// Appending copies of a view elements, a view slices any array without copying,
+		// so elements are copied once here, views of this array are copied through a temporary
+		// 
+		// @param: view - view of elements to copy
+		// return: index of the first added element
+		template < class U >
+		int32 Append(const ArrayView<U>& view)
+		{
+			static_assert(IsSame<typename RemoveConst<U>::type, ElementType>::value, "View elements must be of the array element type");
+
+			if (view.Size() == 0)
+				return INDEX_NONE;
+
+			return InsertRange(view.Data(), view.Size(), _size);
+		}
+
+		// Appending copies of count elements, the array grows once then all elements
+		// are constructed, trivially copyable elements are copied by a single memory copy,
+		// elements of this array are copied through a temporary
+		// 
+		// @param: data - pointer to the first element to copy
+		// @param: count - count of elements to copy
+		// return: index of the first added element
+		int32 Append(const ElementType* data, uint32 count)
+		{
+			if (count == 0)
+				return INDEX_NONE;
+
+			return InsertRange(data, count, _size);
+		}
+
+		// Appending copies of a range of elements, multi pass ranges are counted first
+		// so the array grows once, input only ranges (i.e std::istream_iterator) are added one by one
+		// 
+		// @param: first - iterator to the first element to copy
+		// @param: last - iterator to one past the last element to copy
+		// return: index of the first added element
+		template < class Iterator >
+		_INLINE int32 Append(Iterator first, Iterator last)
+		{
+			return AppendRange(first, last, IteratorCategory<Iterator>(0));
+		}
+
+		// Appending copies of a range of elements
+		// Contiguous range of this array element type, copied like Append(data, count),
+		// pointers to other types are appended by the iterator version
+		template < class U >
+		_INLINE typename EnableIf<IsSame<typename RemoveConst<U>::type, ElementType>::value, int32>::Type
+			Append(U* first, U* last)
+		{
+			return Append(first, (uint32)(last - first));
+		}
+
+		// Appending copies of a range of an array iterators
+		// Contiguous range of this array element type, copied like Append(data, count),
+		// iterators of other types are appended by the iterator version
+		template < class U >
+		_INLINE typename EnableIf<IsSame<typename RemoveConst<U>::type, ElementType>::value, int32>::Type
+			Append(linearIterator<U> first, linearIterator<U> last)
+		{
+			return Append(first.operator->(), (uint32)(last.operator->() - first.operator->()));
+		}
+
 		// Appending a reference array of the same type
 		// 
 		// @param: other - rererence element to copy
 		// return: index of the added element
-		int32 Append(_MyT&& right)
+		int32 Append(_MyT&& other)
 		{
 			//check if other and this are the same
 			if (this == &other || other.Size() == 0)
@@ -400,12 +475,14 @@ public:
 
 			// Add uninitialize elements
 			int32 index = AddUninitialized(other.Size());
+			if (index == INDEX_NONE)
+				return INDEX_NONE; // LOG: OUT OF MEMORY
 
 			// Construct from other array
 			ConstructRangeFromRange(other.Data(), Data(), other.Size(), index);
 
 			//destruct right array
-			right.Release();
+			other.Release();
 
 			// Index of the first element inserted
 			return index;
@@ -422,6 +499,8 @@ public:
 				return INDEX_NONE;
 
 			const int32 index = InsertUninitialized(where);
+			if (index == INDEX_NONE)
+				return INDEX_NONE; // LOG: OUT OF MEMORY
 
 			new(Data() + index) ElementType(element);
 
@@ -439,6 +518,8 @@ public:
 				return INDEX_NONE;
 
 			const int32 index = InsertUninitialized(where);
+			if (index == INDEX_NONE)
+				return INDEX_NONE; // LOG: OUT OF MEMORY
 
 			new(_allocator.Get() + index) ElementType(_EVEREST Move(element));
 
@@ -457,6 +538,8 @@ public:
 
 			// Insert other size
 			where = InsertUninitialized(where, other.Size());
+			if (where == INDEX_NONE)
+				return INDEX_NONE; // LOG: OUT OF MEMORY
 
 			// Copy from other to this array
 			_allocator.ConstructRange(other.Data(), other.Size(), where);
@@ -465,6 +548,23 @@ public:
 			return where;
 		}
 
+		// Insert copies of a view elements in this array start from index,
+		// views of this array are copied through a temporary
+		// 
+		// @param: view - view of elements to copy
+		// @param: where - index to start insertion
+		// @return: inserted at index
+		template < class U >
+		int32 Insert(const ArrayView<U>& view, int32 where)
+		{
+			static_assert(IsSame<typename RemoveConst<U>::type, ElementType>::value, "View elements must be of the array element type");
+
+			if (where < 0 || where > _size || view.Size() == 0)
+				return INDEX_NONE;
+
+			return InsertRange(view.Data(), view.Size(), where);
+		}
+
 		// Insert from other array in this array by copying 
 		// start from index up to count
 		// 
@@ -479,6 +579,8 @@ public:
 
 			// Insert other size
 			where = InsertUninitialized(where, count);
+			if (where == INDEX_NONE)
+				return INDEX_NONE; // LOG: OUT OF MEMORY
 
 			// Copy from other to this array
 			ConstructRangeFromRange(other.Data(), Data(), count, where);
@@ -504,8 +606,10 @@ public:
 
 			// Insert other size
 			where = InsertUninitialized(where, count);
+			if (where == INDEX_NONE)
+				return INDEX_NONE; // LOG: OUT OF MEMORY
 
-			Memory::Memmove(Data() + where, other.Data() + otherWhere, count * GetElementSize());
+			Memmove(Data() + where, other.Data() + otherWhere, count * GetElementSize());
 
 			other.Remove(otherWhere, count, ShrinkOther);
 
@@ -524,6 +628,8 @@ public:
 				return INDEX_NONE;
 
 			where = InsertUninitialized(where, count);
+			if (where == INDEX_NONE)
+				return INDEX_NONE; // LOG: OUT OF MEMORY
 
 			_EVEREST ConstructRange(Data() + where, element, count);
 			//while (count--)
@@ -642,8 +748,8 @@ public:
 			// Ensure capacity
 			if ((count + where) <= _size)
 				;
-			else
-				AddUninitialized(_size - (count + where));
+			else if (AddUninitialized(_size - (count + where)) == INDEX_NONE)
+				return; // LOG: OUT OF MEMORY
 
 			_EVEREST Memmove(Data() + where, other.Data() + otherWhere, count * GetElementSize());
 
@@ -671,20 +777,32 @@ public:
 		// This function will just ensure that array has empty count elements
 		//
 		// @param: count(1) - count of elements to reserve
-		void Reserve(uint32 count = 1)
+		// @return: false if out of memory, the capacity is not changed
+		bool Reserve(uint32 count = 1)
 		{
-			_allocator.Allocate(count);
+			// Exact capacity, then the reserved elements are allocated with no reallocation
+			if (!_allocator.Reserve(_capacity + count) || !_allocator.Allocate(count))
+				return false; // LOG: OUT OF MEMORY
 
 			_capacity += count;
+			return true;
 		}
 
 		// Ensure that array contains empty elements of count
-		// and reverse if not
-		void Ensure(uint32 count)
+		// and reverse if not, the allocator grows by its growth policy
+		//
+		// @return: false if out of memory, the capacity is not changed
+		bool Ensure(uint32 count)
 		{
 			uint32 empty = _capacity - _size;
-			if (count > empty)
-				Reserve(count - empty);
+			if (count <= empty)
+				return true;
+
+			if (!_allocator.Allocate(count - empty))
+				return false; // LOG: OUT OF MEMORY
+
+			_capacity += count - empty;
+			return true;
 		}
 
 		// Check if array is empty
@@ -709,14 +827,9 @@ public:
 		// NOTE: This method assume that element overload operator ==
 		// @param: element - The element to check
 		// @return: true if found
-		bool Contains(const_reference element)
+		bool Contains(const_reference element) const
 		{
-			const_iterator itStart = CreateConstIterator();
-			for (; itStart != cEnd(); ++itStart)
-				if (element == *itStart)
-					return true;
-
-			return false;
+			return FindIndex(Data(), _size, element) != INDEX_NONE;
 		}
 
 		// Finds an element searching forward the array, return it's index if found
@@ -726,16 +839,11 @@ public:
 		// @return: index of the element of found, -1 otherwise
 		int32 Find(const_reference element, int32 start = 0)
 		{
-			const_iterator itStart = CreateConstIterator(start);
-			for (; itStart != cEnd(); ++itStart)
-			{
-				if (element == *itStart)
-					return start;
-
-				start++;
-			}
+			if (start < 0 || start >= _size)
+				return INDEX_NONE;
 
-			return INDEX_NONE;
+			SSIZE_T index = FindIndex(Data() + start, _size - start, element);
+			return index == INDEX_NONE ? INDEX_NONE : start + (int32)index;
 		}
 
 		// Finds an element searching backward the array, return it's index if found
@@ -744,17 +852,7 @@ public:
 		// @return: index of the element of found, -1 otherwise
 		int32 FindLast(const_reference element)
 		{
-			const_reverse_iterator itStart = CreateConstReverseIterator();
-			uint32 index = _size - 1;
-			for (; itStart != crEnd(); ++itStart)
-			{
-				if (element == *itStart)
-					return index;
-
-				index--;
-			}
-
-			return INDEX_NONE;
+			return (int32)FindLastIndex(Data(), _size, element);
 		}
 
 		//TODO: Find by Predicate
@@ -764,8 +862,8 @@ public:
 		// @param: start - index to start copy
 		// @param: count - count of elements to copy
 		// @return: new array with the copies elements
-		template<typename T, typename _Allocator>
-		void CopyFrom(const Array<T, _Allocator>& source, uint32 start, uint32 count)
+		template<typename T_, typename _Allocator>
+		void CopyFrom(const Array<T_, _Allocator>& source, uint32 start, uint32 count)
 		{
 			if (start > source._size || count > source._size - start)
 				return;
@@ -781,19 +879,7 @@ public:
 		// @return: the index of element if found, -1 otherwise (INDEX_NONE)
 		int32 IndexOf(const_reference element)
 		{
-			int32 index = 0;
-			const_iterator itStart = CreateConstIterator();
-			const_iterator itEnd = CreateConstIterator(_size);
-
-			for (; itStart != itEnd; ++itStart)
-			{
-				if (*itStart == element)
-					return index;
-
-				index++;
-			}
-
-			return INDEX_NONE;
+			return (int32)FindIndex(Data(), _size, element);
 		}
 
 		// Return an iterator start from some index
@@ -1062,7 +1148,7 @@ public:
 		_INLINE bool operator==(const _MyT& other)
 		{
 			return (_size == other.Size())
-				&& (Data() == other.Data())
+				&& (Data() == other.Data());
 		}
 
 		// Return a pointer to the first element of the array
@@ -1091,7 +1177,13 @@ public:
 		}
 
 		// Return a reference to this array allocator instance
-		_INLINE Allocator& GetAllocator() const
+		_INLINE Allocator& GetAllocator()
+		{
+			return _allocator;
+		}
+
+		// Return a const reference to this array allocator instance
+		_INLINE const Allocator& GetAllocator() const
 		{
 			return _allocator;
 		}
@@ -1115,7 +1207,8 @@ public:
 			// store index for the first item to add
 			int32 index = _size;
 
-			Ensure(count);
+			if (!Ensure(count))
+				return INDEX_NONE; // LOG: OUT OF MEMORY
 
 			_size += count; // new size
 
@@ -1129,7 +1222,8 @@ public:
 		int32 InsertUninitialized(int32 where, uint32 count = 1)
 		{
 			// Add space to elements 
-			AddUninitialized(count);
+			if (AddUninitialized(count) == INDEX_NONE)
+				return INDEX_NONE;
 
 			// Shift elements back, if needed
 			if ((where + count) == _size)
@@ -1143,6 +1237,117 @@ public:
 			return where;
 		}
 
+		// Category of iterators with no std traits, the containers iterators are multi pass
+		struct MultiPassIterator {};
+
+		// Return the category of an iterator
+		template < class Iterator >
+		_INLINE static auto IteratorCategory(int) -> typename std::iterator_traits<Iterator>::iterator_category
+		{
+			return typename std::iterator_traits<Iterator>::iterator_category();
+		}
+
+		template < class Iterator >
+		_INLINE static MultiPassIterator IteratorCategory(...)
+		{
+			return MultiPassIterator();
+		}
+
+		// Input only range can be passed once, elements are added one by one
+		template < class Iterator >
+		int32 AppendRange(Iterator first, Iterator last, std::input_iterator_tag)
+		{
+			int32 index = _size;
+			for (; first != last; ++first)
+			{
+				if (Emplace(*first) == INDEX_NONE)
+					return INDEX_NONE; // LOG: OUT OF MEMORY
+			}
+
+			return index == _size ? INDEX_NONE : index;
+		}
+
+		// Forward range of std iterators, random access ranges are counted in constant time
+		template < class Iterator >
+		_INLINE int32 AppendRange(Iterator first, Iterator last, std::forward_iterator_tag)
+		{
+			return AppendCounted(first, last, (uint32)std::distance(first, last));
+		}
+
+		// Containers iterators range, counted by a pass
+		template < class Iterator >
+		int32 AppendRange(Iterator first, Iterator last, MultiPassIterator)
+		{
+			uint32 count = 0;
+			for (Iterator it = first; it != last; ++it)
+				count++;
+
+			return AppendCounted(first, last, count);
+		}
+
+		// Append a counted range, the array grows once then the elements are constructed
+		template < class Iterator >
+		int32 AppendCounted(Iterator first, Iterator last, uint32 count)
+		{
+			if (count == 0)
+				return INDEX_NONE;
+
+			// Add uninitialize elements
+			int32 index = AddUninitialized(count);
+			if (index == INDEX_NONE)
+				return INDEX_NONE; // LOG: OUT OF MEMORY
+
+			// Construct from range
+			ElementType* dest = Data() + index;
+			for (; first != last; ++first, ++dest)
+				new(dest) ElementType(*first);
+
+			return index;
+		}
+
+		// Insert copies of count elements at where,
+		// elements of this array are copied to a temporary first, as inserting may move them
+		//
+		// @param: data - pointer to the first element to copy
+		// @param: count - count of elements to copy
+		// @param: where - index to insert at
+		// @return: inserted at index, INDEX_NONE if out of memory
+		int32 InsertRange(const ElementType* data, uint32 count, int32 where)
+		{
+			if (Overlaps(data))
+			{
+				std::shared_ptr<DynamicSegment> segment = _allocator.GetSegmentManager();
+				UINTPTR handle = segment->Alloc((SIZE_T)sizeof(ElementType) * count, alignof(ElementType));
+				if (!handle)
+					return INDEX_NONE; // LOG: OUT OF MEMORY
+
+				ElementType* copy = (ElementType*)DynamicSegment::PointerOf(handle);
+				ConstructRangeFromRange(data, copy, count);
+
+				where = InsertRange(copy, count, where);
+
+				_EVEREST Destroy(copy, count);
+				segment->Dealloc(handle);
+				return where;
+			}
+
+			where = InsertUninitialized(where, count);
+			if (where == INDEX_NONE)
+				return INDEX_NONE; // LOG: OUT OF MEMORY
+
+			ConstructRangeFromRange(data, Data(), count, where);
+			return where;
+		}
+
+		// Check if an element address is in this array allocation
+		//
+		// @param: element - The address to check
+		_INLINE bool Overlaps(const void* element) const
+		{
+			const ElementType* data = Data();
+			return element >= (const void*)data && element < (const void*)(data + _capacity);
+		}
+
 		// Check if index in array range and validate it if not in range
 		//
 		// @param: index - byref index to validate
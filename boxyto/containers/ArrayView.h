@@ -0,0 +1,199 @@
+/*****************************************************************************
+The MIT License(MIT)
+
+Copyright(c) 2016 Amr Esam
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*********************************************************************************/
+#pragma once
+
+#include "../system.h"
+#include "../Template/Common.h"
+#include "../algorithms/Find.h"
+#include "Array.h"
+
+namespace Everest
+{
+   /*
+	* ArrayView Class, a non owning view of contiguous elements.
+	*
+	* A view is a pointer & a size, it is created from an Array, a SmallArray or any container
+	* with Data() & Size(), and sliced without allocating or copying elements.
+	* Use ArrayView<const T> for read only views.
+	*
+	* A view does not keep elements alive, it is invalid once the viewed array grows,
+	* shrinks or is destroyed.
+	*
+	* @param: T - Element type, const T for read only views
+	*/
+	template < class T >
+	class ArrayView
+	{
+	public:
+
+		// typedefs
+		typedef ArrayView<T> _MyT;
+		typedef T ElementType;
+		typedef ElementType& reference;
+		typedef ElementType* pointer;
+
+		typedef linearIterator<ElementType> iterator;
+		typedef linearIterator<const ElementType> const_iterator;
+
+		// Create an empty view
+		ArrayView() :
+			_data(nullptr),
+			_size(0)
+		{}
+
+		// Create a view of elements
+		//
+		// @param: data - Pointer to the first element
+		// @param: size - Count of elements
+		ArrayView(pointer data, uint32 size) :
+			_data(data),
+			_size(size)
+		{}
+
+		// Create a view of all container elements
+		//
+		// @param: container - Array or any container with contiguous Data() & Size()
+		template < class Container >
+		ArrayView(Container& container) :
+			_data(container.Data()),
+			_size(container.Size())
+		{}
+
+		// Create a view of a range of container elements, the range is clamped to the container
+		//
+		// @param: container - Array or any container with contiguous Data() & Size()
+		// @param: start - Index of the first element
+		// @param: count - Count of elements
+		template < class Container >
+		ArrayView(Container& container, uint32 start, uint32 count) :
+			ArrayView(_MyT(container).Slice(start, count))
+		{}
+
+		// Return a view of a range of this view, the range is clamped to this view
+		//
+		// @param: start - Index of the first element
+		// @param: count - Count of elements
+		// @return: the sub view, empty if start is past the end
+		_MyT Slice(uint32 start, uint32 count) const
+		{
+			if (start >= _size)
+				return _MyT();
+
+			return _MyT(_data + start, count < _size - start ? count : _size - start);
+		}
+
+		// Return a view of this view elements from start to the end
+		//
+		// @param: start - Index of the first element
+		// @return: the sub view, empty if start is past the end
+		_INLINE _MyT Slice(uint32 start) const
+		{
+			return start >= _size ? _MyT() : _MyT(_data + start, _size - start);
+		}
+
+		// Return pointer to the first element
+		_INLINE pointer Data() const
+		{
+			return _data;
+		}
+
+		// Return count of elements
+		_INLINE uint32 Size() const
+		{
+			return _size;
+		}
+
+		// Check if the view has no elements
+		_INLINE bool Empty() const
+		{
+			return _size == 0;
+		}
+
+		// Return element at index
+		_INLINE reference operator[](uint32 index) const
+		{
+			return _data[index];
+		}
+
+		// Return index of a given element
+		//
+		// @param: element - The element to get index for
+		// @return: the index of element if found, INDEX_NONE otherwise
+		_INLINE int32 IndexOf(const ElementType& element) const
+		{
+			return (int32)FindIndex(_data, _size, element);
+		}
+
+		// Check if element is in the view
+		_INLINE bool Contains(const ElementType& element) const
+		{
+			return FindIndex(_data, _size, element) != INDEX_NONE;
+		}
+
+		// Return an iterator start from some index
+		_INLINE iterator CreateIterator(uint32 start = 0) const
+		{
+			return iterator(_data + start, start);
+		}
+
+		// Return a const iterator start from some index
+		_INLINE const_iterator CreateConstIterator(uint32 start = 0) const
+		{
+			return const_iterator(_data + start, start);
+		}
+
+		// Get iterator to first element
+		_INLINE iterator Begin() const
+		{
+			return iterator(_data, 0);
+		}
+
+		// Get iterator to one past the last element
+		_INLINE iterator End() const
+		{
+			return iterator(_data + _size, _size);
+		}
+
+		// Get const iterator to first element
+		_INLINE const_iterator cBegin() const
+		{
+			return const_iterator(_data, 0);
+		}
+
+		// Get const iterator to one past the last element
+		_INLINE const_iterator cEnd() const
+		{
+			return const_iterator(_data + _size, _size);
+		}
+
+	private:
+
+		// First element
+		pointer _data;
+
+		// Count of elements
+		uint32 _size;
+	};
+}
@@ -0,0 +1,546 @@
+/*****************************************************************************
+The MIT License(MIT)
+
+Copyright(c) 2016 Amr Esam
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*********************************************************************************/
+#pragma once
+
+#include "../system.h"
+#include "../Template/Common.h"
+#include "../memory/DynamicSegment.h"
+#include "../memory/LinearAllocator.h"
+#include "Array.h"
+
+#include <memory>
+
+// Bulk operations are selected at compile time, SSE2 is always available on x64 & on x86 built for it,
+// AVX2 is used when the compiler targets it (/arch:AVX2 or -mavx2)
+#if defined(_M_X64) || defined(__x86_64__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2) || defined(__SSE2__)
+#define SIMD_BITS_SSE2
+#include <emmintrin.h>
+#if defined(__AVX2__)
+#define SIMD_BITS_AVX2
+#include <immintrin.h>
+#endif
+#endif
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace Everest
+{
+	// Return index of the lowest set bit in a non zero word
+	_INLINE uint32 LowestBit64(uint64 word)
+	{
+#if defined(_MSC_VER) && defined(_M_X64)
+		unsigned long index;
+		_BitScanForward64(&index, word);
+		return index;
+#elif defined(_MSC_VER)
+		unsigned long index;
+		if (_BitScanForward(&index, (uint32)word))
+			return index;
+		_BitScanForward(&index, (uint32)(word >> 32));
+		return index + 32;
+#else
+		return (uint32)__builtin_ctzll(word);
+#endif
+	}
+
+	// Return count of set bits in a word
+	_INLINE uint32 PopCount64(uint64 word)
+	{
+#if defined(__GNUC__)
+		return (uint32)__builtin_popcountll(word);
+#else
+		// popcnt instruction is not in the x64 base, count by bit fields
+		word = word - ((word >> 1) & 0x5555555555555555ull);
+		word = (word & 0x3333333333333333ull) + ((word >> 2) & 0x3333333333333333ull);
+		word = (word + (word >> 4)) & 0x0F0F0F0F0F0F0F0Full;
+		return (uint32)((word * 0x0101010101010101ull) >> 56);
+#endif
+	}
+
+	// Bulk word operations of BitArray, each operation combines words of two bit arrays
+	struct BitAnd
+	{
+		_INLINE static uint64 Apply(uint64 left, uint64 right) { return left & right; }
+#if defined(SIMD_BITS_SSE2)
+		_INLINE static __m128i Apply(__m128i left, __m128i right) { return _mm_and_si128(left, right); }
+#endif
+#if defined(SIMD_BITS_AVX2)
+		_INLINE static __m256i Apply(__m256i left, __m256i right) { return _mm256_and_si256(left, right); }
+#endif
+	};
+
+	struct BitOr
+	{
+		_INLINE static uint64 Apply(uint64 left, uint64 right) { return left | right; }
+#if defined(SIMD_BITS_SSE2)
+		_INLINE static __m128i Apply(__m128i left, __m128i right) { return _mm_or_si128(left, right); }
+#endif
+#if defined(SIMD_BITS_AVX2)
+		_INLINE static __m256i Apply(__m256i left, __m256i right) { return _mm256_or_si256(left, right); }
+#endif
+	};
+
+	struct BitXor
+	{
+		_INLINE static uint64 Apply(uint64 left, uint64 right) { return left ^ right; }
+#if defined(SIMD_BITS_SSE2)
+		_INLINE static __m128i Apply(__m128i left, __m128i right) { return _mm_xor_si128(left, right); }
+#endif
+#if defined(SIMD_BITS_AVX2)
+		_INLINE static __m256i Apply(__m256i left, __m256i right) { return _mm256_xor_si256(left, right); }
+#endif
+	};
+
+	// left & ~right
+	struct BitAndNot
+	{
+		_INLINE static uint64 Apply(uint64 left, uint64 right) { return left & ~right; }
+#if defined(SIMD_BITS_SSE2)
+		_INLINE static __m128i Apply(__m128i left, __m128i right) { return _mm_andnot_si128(right, left); }
+#endif
+#if defined(SIMD_BITS_AVX2)
+		_INLINE static __m256i Apply(__m256i left, __m256i right) { return _mm256_andnot_si256(right, left); }
+#endif
+	};
+
+	// Combine words of right into left by an operation
+	//
+	// @param: left - Words to update
+	// @param: right - Words to combine with
+	// @param: count - Count of words
+	template < class Operation >
+	void BitWordsApply(uint64* left, const uint64* right, uint32 count)
+	{
+		uint32 index = 0;
+#if defined(SIMD_BITS_AVX2)
+		for (; index + 4 <= count; index += 4)
+		{
+			__m256i value = Operation::Apply(_mm256_loadu_si256((const __m256i*)(left + index)), _mm256_loadu_si256((const __m256i*)(right + index)));
+			_mm256_storeu_si256((__m256i*)(left + index), value);
+		}
+#endif
+#if defined(SIMD_BITS_SSE2)
+		for (; index + 2 <= count; index += 2)
+		{
+			__m128i value = Operation::Apply(_mm_loadu_si128((const __m128i*)(left + index)), _mm_loadu_si128((const __m128i*)(right + index)));
+			_mm_storeu_si128((__m128i*)(left + index), value);
+		}
+#endif
+		for (; index < count; index++)
+			left[index] = Operation::Apply(left[index], right[index]);
+	}
+
+	// Count set bits of words
+	//
+	// @param: words - Words to count bits of
+	// @param: count - Count of words
+	// @return: count of set bits
+	inline uint64 BitWordsCount(const uint64* words, uint32 count)
+	{
+		uint64 bits = 0;
+		uint32 index = 0;
+#if defined(SIMD_BITS_AVX2)
+		// Nibble lookup table, byte counts are summed by sad against zero
+		const __m256i table = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+			0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+		const __m256i low = _mm256_set1_epi8(0x0F);
+		__m256i sums = _mm256_setzero_si256();
+		for (; index + 4 <= count; index += 4)
+		{
+			__m256i value = _mm256_loadu_si256((const __m256i*)(words + index));
+			__m256i counts = _mm256_add_epi8(_mm256_shuffle_epi8(table, _mm256_and_si256(value, low)),
+				_mm256_shuffle_epi8(table, _mm256_and_si256(_mm256_srli_epi16(value, 4), low)));
+			sums = _mm256_add_epi64(sums, _mm256_sad_epu8(counts, _mm256_setzero_si256()));
+		}
+
+		uint64 lanes[4];
+		_mm256_storeu_si256((__m256i*)lanes, sums);
+		bits += lanes[0] + lanes[1] + lanes[2] + lanes[3];
+#endif
+#if defined(SIMD_BITS_SSE2)
+		// Bit fields counts, byte counts are summed by sad against zero
+		const __m128i m1 = _mm_set1_epi8(0x55);
+		const __m128i m2 = _mm_set1_epi8(0x33);
+		const __m128i m4 = _mm_set1_epi8(0x0F);
+		__m128i sums128 = _mm_setzero_si128();
+		for (; index + 2 <= count; index += 2)
+		{
+			__m128i value = _mm_loadu_si128((const __m128i*)(words + index));
+			value = _mm_sub_epi8(value, _mm_and_si128(_mm_srli_epi64(value, 1), m1));
+			value = _mm_add_epi8(_mm_and_si128(value, m2), _mm_and_si128(_mm_srli_epi64(value, 2), m2));
+			value = _mm_and_si128(_mm_add_epi8(value, _mm_srli_epi64(value, 4)), m4);
+			sums128 = _mm_add_epi64(sums128, _mm_sad_epu8(value, _mm_setzero_si128()));
+		}
+
+		uint64 lanes128[2];
+		_mm_storeu_si128((__m128i*)lanes128, sums128);
+		bits += lanes128[0] + lanes128[1];
+#endif
+		for (; index < count; index++)
+			bits += PopCount64(words[index]);
+
+		return bits;
+	}
+
+   /*
+	* BitArray Class, a dynamic array of bits packed in 64 bit words.
+	*
+	* Takes 1 bit per element instead of a byte of Array<bool>, whole bit arrays are combined
+	* by And/Or/Xor/AndNot word by word, 256 or 128 bits at a time with AVX2 or SSE2.
+	*
+	* Bits past Size() in the last word are always zero, so counting & finding never
+	* have to mask the last word.
+	*/
+	class BitArray
+	{
+		typedef Array<uint64, LinearAllocator<uint64>> WordTable;
+
+	public:
+
+		// typedefs
+		typedef BitArray _MyT;
+		typedef uint64 WordType;
+
+		// Bits per word
+		enum { WORD_BITS = 64, WORD_SHIFT = 6, WORD_MASK = WORD_BITS - 1 };
+
+		// Delete default constructor
+		BitArray() = delete;
+
+		// Create an empty bit array
+		//
+		// @param: segment - The segment to allocate words from
+		BitArray(std::shared_ptr<DynamicSegment> segment) :
+			_size(0),
+			_words(LinearAllocator<uint64>(segment, DEFAULT_CONTAINER_CAPACITY))
+		{}
+
+		// Create a bit array of count bits
+		//
+		// @param: count - Count of bits
+		// @param: value - Value of all bits
+		// @param: segment - The segment to allocate words from
+		BitArray(uint32 count, bool value, std::shared_ptr<DynamicSegment> segment) :
+			BitArray(segment)
+		{
+			Resize(count, value);
+		}
+
+		// Copy from other bit array constructor
+		//
+		// @param: other - Bit array to copy from
+		BitArray(const _MyT& other) :
+			_size(other._size),
+			_words(other._words.GetAllocator())
+		{
+			_words.Append(other._words);
+		}
+
+		// Return count of bits
+		_INLINE uint32 Size() const
+		{
+			return _size;
+		}
+
+		// Check if the array has no bits
+		_INLINE bool Empty() const
+		{
+			return _size == 0;
+		}
+
+		// Return count of words
+		_INLINE uint32 WordCount() const
+		{
+			return _words.Size();
+		}
+
+		// Return pointer to the first word, bit index is word index * WORD_BITS + bit
+		_INLINE uint64* Words()
+		{
+			return _words.Data();
+		}
+
+		// Return const pointer to the first word
+		_INLINE const uint64* Words() const
+		{
+			return _words.Data();
+		}
+
+		// Resize to count bits, added bits are set to value
+		//
+		// @param: count - New count of bits
+		// @param: value(false) - Value of added bits
+		void Resize(uint32 count, bool value = false)
+		{
+			const uint32 words = WordsOf(count);
+			if (count > _size)
+			{
+				// Fill the tail of the current last word
+				if (value && (_size & WORD_MASK))
+					_words.Data()[_size >> WORD_SHIFT] |= ~0ull << (_size & WORD_MASK);
+
+				_words.Ensure(words - _words.Size());
+				while (_words.Size() < words)
+					_words.Add(value ? ~0ull : 0ull);
+			}
+			else if (words < _words.Size())
+				_words.Remove(words, _words.Size() - words);
+
+			_size = count;
+			ClearTail();
+		}
+
+		// Add a bit at the end
+		//
+		// @param: value - Value of the bit
+		// @return: index of the added bit
+		int32 Add(bool value)
+		{
+			if ((_size & WORD_MASK) == 0)
+				_words.Add(0ull);
+
+			if (value)
+				_words.Data()[_size >> WORD_SHIFT] |= 1ull << (_size & WORD_MASK);
+
+			return _size++;
+		}
+
+		// Return value of bit at index
+		_INLINE bool Test(uint32 index) const
+		{
+			return (_words.Data()[index >> WORD_SHIFT] >> (index & WORD_MASK)) & 1;
+		}
+
+		// Return value of bit at index
+		_INLINE bool operator[](uint32 index) const
+		{
+			return Test(index);
+		}
+
+		// Set bit at index
+		_INLINE void Set(uint32 index)
+		{
+			_words.Data()[index >> WORD_SHIFT] |= 1ull << (index & WORD_MASK);
+		}
+
+		// Set bit at index to value, without branching
+		_INLINE void Set(uint32 index, bool value)
+		{
+			uint64& word = _words.Data()[index >> WORD_SHIFT];
+			const uint64 bit = 1ull << (index & WORD_MASK);
+			word = (word & ~bit) | ((0ull - (uint64)value) & bit);
+		}
+
+		// Clear bit at index
+		_INLINE void Reset(uint32 index)
+		{
+			_words.Data()[index >> WORD_SHIFT] &= ~(1ull << (index & WORD_MASK));
+		}
+
+		// Flip bit at index
+		_INLINE void Flip(uint32 index)
+		{
+			_words.Data()[index >> WORD_SHIFT] ^= 1ull << (index & WORD_MASK);
+		}
+
+		// Set all bits to value
+		void SetAll(bool value)
+		{
+			uint64* words = _words.Data();
+			for (uint32 index = 0; index < _words.Size(); index++)
+				words[index] = value ? ~0ull : 0ull;
+
+			ClearTail();
+		}
+
+		// Flip all bits
+		void FlipAll()
+		{
+			uint64* words = _words.Data();
+			for (uint32 index = 0; index < _words.Size(); index++)
+				words[index] = ~words[index];
+
+			ClearTail();
+		}
+
+		// Bits &= other bits
+		//
+		// @param: other - Bit array of the same size
+		// @return: false if sizes are different
+		_INLINE bool And(const _MyT& other)
+		{
+			return Apply<BitAnd>(other);
+		}
+
+		// Bits |= other bits
+		//
+		// @param: other - Bit array of the same size
+		// @return: false if sizes are different
+		_INLINE bool Or(const _MyT& other)
+		{
+			return Apply<BitOr>(other);
+		}
+
+		// Bits ^= other bits
+		//
+		// @param: other - Bit array of the same size
+		// @return: false if sizes are different
+		_INLINE bool Xor(const _MyT& other)
+		{
+			return Apply<BitXor>(other);
+		}
+
+		// Bits &= ~other bits, removes other members from this mask
+		//
+		// @param: other - Bit array of the same size
+		// @return: false if sizes are different
+		_INLINE bool AndNot(const _MyT& other)
+		{
+			return Apply<BitAndNot>(other);
+		}
+
+		// Return count of set bits
+		_INLINE uint64 Count() const
+		{
+			return BitWordsCount(_words.Data(), _words.Size());
+		}
+
+		// Check if any bit is set
+		bool Any() const
+		{
+			const uint64* words = _words.Data();
+			for (uint32 index = 0; index < _words.Size(); index++)
+				if (words[index])
+					return true;
+
+			return false;
+		}
+
+		// Find the first set bit at or after start
+		//
+		// @param: start(0) - Index to start from
+		// @return: index of the set bit, INDEX_NONE if not found
+		int32 FindNextSet(uint32 start = 0) const
+		{
+			if (start >= _size)
+				return INDEX_NONE;
+
+			const uint64* words = _words.Data();
+			uint32 index = start >> WORD_SHIFT;
+			uint64 word = words[index] & (~0ull << (start & WORD_MASK));
+			while (!word)
+			{
+				if (++index == _words.Size())
+					return INDEX_NONE;
+				word = words[index];
+			}
+
+			return (index << WORD_SHIFT) + LowestBit64(word);
+		}
+
+		// Find the first clear bit at or after start
+		//
+		// @param: start(0) - Index to start from
+		// @return: index of the clear bit, INDEX_NONE if not found
+		int32 FindNextClear(uint32 start = 0) const
+		{
+			if (start >= _size)
+				return INDEX_NONE;
+
+			const uint64* words = _words.Data();
+			uint32 index = start >> WORD_SHIFT;
+			uint64 word = ~words[index] & (~0ull << (start & WORD_MASK));
+			while (!word)
+			{
+				if (++index == _words.Size())
+					return INDEX_NONE;
+				word = ~words[index];
+			}
+
+			// Tail bits are zero, their inverse is past Size()
+			uint32 found = (index << WORD_SHIFT) + LowestBit64(word);
+			return found < _size ? (int32)found : INDEX_NONE;
+		}
+
+		// Remove all bits
+		_INLINE void Clear()
+		{
+			_words.Clear();
+			_size = 0;
+		}
+
+		// Remove all bits and free memory
+		_INLINE void Release()
+		{
+			_words.Release();
+			_size = 0;
+		}
+
+		// Assignment operator
+		_MyT& operator=(const _MyT& other)
+		{
+			if (this != &other)
+			{
+				_words.Clear();
+				_words.Append(other._words);
+				_size = other._size;
+			}
+			return *this;
+		}
+
+	private:
+
+		// Return count of words for count bits
+		_INLINE static uint32 WordsOf(uint32 count)
+		{
+			return (count + WORD_MASK) >> WORD_SHIFT;
+		}
+
+		// Zero the bits past Size() in the last word
+		_INLINE void ClearTail()
+		{
+			if (_size & WORD_MASK)
+				_words.Data()[_size >> WORD_SHIFT] &= ~(~0ull << (_size & WORD_MASK));
+		}
+
+		// Combine other words into this words
+		template < class Operation >
+		bool Apply(const _MyT& other)
+		{
+			if (_size != other._size)
+				return false; // LOG: Bit arrays sizes are different
+
+			BitWordsApply<Operation>(_words.Data(), other._words.Data(), _words.Size());
+			return true;
+		}
+
+		// Count of bits
+		uint32 _size;
+
+		// Bits words
+		WordTable _words;
+	};
+}
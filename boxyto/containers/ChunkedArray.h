@@ -0,0 +1,355 @@
+/*****************************************************************************
+The MIT License(MIT)
+
+Copyright(c) 2016 Amr Esam
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*********************************************************************************/
+#pragma once
+
+#include "../system.h"
+#include "../Template/Common.h"
+#include "../memory/MemoryOps.h"
+#include "../memory/DynamicSegment.h"
+#include "../memory/LinearAllocator.h"
+#include "../memory/Pointer.h"
+#include "Array.h"
+
+/* For std::shared_ptr */
+#include <memory>
+
+namespace Everest
+{
+	// Forward iterator over elements of a chunked container, by index
+	template < class Container, class T >
+	class chunkedIterator
+	{
+	public:
+		typedef chunkedIterator<Container, T> _MyT;
+		typedef T ElementType;
+		typedef T& reference;
+		typedef T* pointer;
+
+		chunkedIterator(Container* container, uint32 index) : _container(container), _index(index)
+		{ }
+
+		_MyT& operator++()
+		{
+			_index++; return *this;
+		}
+
+		_MyT operator++(int junk)
+		{
+			_MyT i = *this;
+			_index++;
+			return i;
+		}
+
+		reference operator*()
+		{
+			return (*_container)[_index];
+		}
+
+		pointer operator->()
+		{
+			return &(*_container)[_index];
+		}
+
+		bool operator==(const _MyT& rhs)
+		{
+			return _index == rhs._index;
+		}
+
+		bool operator!=(const _MyT& rhs)
+		{
+			return _index != rhs._index;
+		}
+
+		_INLINE uint32 GetIndex() const
+		{
+			return _index;
+		}
+
+	private:
+		Container* _container;
+		uint32 _index;
+	};
+
+   /*
+	* ChunkedArray Class, a segmented array of fixed size blocks.
+	*
+	* The array grows by allocating a new block of BLOCK_SIZE elements from a DynamicSegment,
+	* so appending never copies existing elements, and pointers to elements stay valid.
+	* A table of block pointers gives O(1) random access.
+	*
+	* Blocks are referenced by CachedPointer, they resolve again if the segment is defragmented,
+	* references to elements are stable as long as the segment is not defragmented.
+	*
+	* @param: T - Element type
+	* @param: BLOCK_SHIFT(10) - Log2 of elements count per block
+	*/
+	template < class T, uint32 BLOCK_SHIFT = 10 >
+	class ChunkedArray
+	{
+		typedef CachedPointer<T> BlockPointer;
+		typedef Array<BlockPointer, LinearAllocator<BlockPointer>> BlockTable;
+
+	public:
+
+		// typedefs
+		typedef ChunkedArray<T, BLOCK_SHIFT> _MyT;
+		typedef T ElementType;
+		typedef ElementType& reference;
+		typedef ElementType&& rvalue;
+		typedef const ElementType& const_reference;
+
+		typedef chunkedIterator<_MyT, ElementType> iterator;
+		typedef chunkedIterator<const _MyT, const ElementType> const_iterator;
+
+		// Elements count per block
+		enum { BLOCK_SIZE = 1 << BLOCK_SHIFT };
+
+		// Delete default constructor
+		ChunkedArray() = delete;
+
+		// Create an empty array, no block is allocated until the first element added
+		//
+		// @param: segment - The segment to allocate blocks from
+		ChunkedArray(std::shared_ptr<DynamicSegment> segment) :
+			_size(0),
+			_segment(segment),
+			_blocks(LinearAllocator<BlockPointer>(segment, DEFAULT_CONTAINER_CAPACITY))
+		{}
+
+		// Copy from other array constructor
+		//
+		// @param: other - Array to copy from
+		ChunkedArray(const _MyT& other) :
+			_size(0),
+			_segment(other._segment),
+			_blocks(LinearAllocator<BlockPointer>(other._segment, DEFAULT_CONTAINER_CAPACITY))
+		{
+			Append(other);
+		}
+
+		// Destructor, destroy all elements and free all blocks
+		~ChunkedArray()
+		{
+			Release();
+		}
+
+		// Copy this array from other array, all blocks are released first
+		//
+		// @param: other - array to copy from
+		// @return: reference to this array
+		_INLINE _MyT& operator=(const _MyT& other)
+		{
+			if (this != &other)
+			{
+				Release();
+				Append(other);
+			}
+			return *this;
+		}
+
+		// Construct an element at the end of the array
+		//
+		// @param: args - element constructor arguments
+		// @return: index of the added element, INDEX_NONE if out of memory
+		template < class... Args >
+		int32 Emplace(Args&&... args)
+		{
+			if (_size == Capacity() && !AddBlock())
+				return INDEX_NONE;
+
+			new (Address(_size)) ElementType(_EVEREST Forward<Args>(args)...);
+			return _size++;
+		}
+
+		// Add a copy of an element at the end of the array
+		//
+		// @param: element - The element to copy
+		// @return: index of the added element, INDEX_NONE if out of memory
+		_INLINE int32 Add(const_reference element)
+		{
+			return Emplace(element);
+		}
+
+		// Add a moved element at the end of the array
+		//
+		// @param: element - The element to move
+		// @return: index of the added element, INDEX_NONE if out of memory
+		_INLINE int32 Add(rvalue element)
+		{
+			return Emplace(_EVEREST Move(element));
+		}
+
+		// Append copies of all other array elements
+		//
+		// @param: other - Array to copy from
+		// @return: index of the first added element, INDEX_NONE if empty or out of memory
+		int32 Append(const _MyT& other)
+		{
+			if (this == &other || other.Size() == 0 || !Reserve(_size + other.Size()))
+				return INDEX_NONE;
+
+			int32 index = _size;
+			for (uint32 i = 0; i < other.Size(); i++)
+				Emplace(other[i]);
+
+			return index;
+		}
+
+		// Remove the last element(s), elements are never moved so only last elements can be removed
+		//
+		// @param: count(1) - count of elements to remove
+		void RemoveLast(uint32 count = 1)
+		{
+			if (count > _size)
+				count = _size;
+
+			while (count--)
+				_EVEREST Destroy(Address(--_size), 1);
+		}
+
+		// Destroy all elements, blocks are kept for reuse
+		void Clear()
+		{
+			RemoveLast(_size);
+		}
+
+		// Destroy all elements and free all blocks
+		void Release()
+		{
+			Clear();
+
+			for (uint32 i = 0; i < _blocks.Size(); i++)
+				_segment->Dealloc(_blocks[i].GetHandle());
+
+			_blocks.Clear();
+		}
+
+		// Allocate blocks to hold count of elements
+		//
+		// @param: count - count of elements
+		// @return: false if out of memory
+		bool Reserve(uint32 count)
+		{
+			while (Capacity() < count)
+				if (!AddBlock())
+					return false;
+
+			return true;
+		}
+
+		// Return element at index
+		_INLINE reference operator[](uint32 index)
+		{
+			return *Address(index);
+		}
+
+		// Return element at index
+		_INLINE const_reference operator[](uint32 index) const
+		{
+			return *Address(index);
+		}
+
+		// Return the last element
+		_INLINE reference Top()
+		{
+			return *Address(_size - 1);
+		}
+
+		// Return a pointer to the block at blockIndex, block elements are contiguous
+		_INLINE ElementType* GetBlock(uint32 blockIndex) const
+		{
+			return _blocks.Data()[blockIndex].Get();
+		}
+
+		// Returns an iterator to the begin of the array
+		iterator Begin()
+		{
+			return iterator(this, 0);
+		}
+
+		// Returns a const iterator to the begin of the array
+		const_iterator cBegin() const
+		{
+			return const_iterator(this, 0);
+		}
+
+		// Returns an iterator to the end of the array
+		iterator End()
+		{
+			return iterator(this, _size);
+		}
+
+		// Returns a const iterator to the end of the array
+		const_iterator cEnd() const
+		{
+			return const_iterator(this, _size);
+		}
+
+		// Returns true if the array is empty
+		_INLINE bool Empty() const { return _size == 0; }
+
+		// Returns count of allocated blocks
+		_INLINE uint32 BlockCount() const { return _blocks.Size(); }
+
+		// Returns the array capacity, all allocated blocks elements
+		_INLINE uint32 Capacity() const { return _blocks.Size() << BLOCK_SHIFT; }
+
+		// Returns the actual size of the array
+		_INLINE uint32 Size() const { return _size; }
+
+	private:
+
+		// Return address of element at index
+		_INLINE ElementType* Address(uint32 index) const
+		{
+			return _blocks.Data()[index >> BLOCK_SHIFT].Get() + (index & (BLOCK_SIZE - 1));
+		}
+
+		// Allocate a new block at the end
+		//
+		// @return: false if out of memory
+		bool AddBlock()
+		{
+			UINTPTR handle = _segment->Alloc(sizeof(ElementType) * BLOCK_SIZE, alignof(ElementType));
+			if (!handle)
+				return false; // LOG: OUT OF MEMORY
+
+			_blocks.Add(BlockPointer(handle));
+			return true;
+		}
+
+	private:
+
+		// Count of constructed elements
+		uint32 _size;
+
+		// Segment to allocate blocks from
+		std::shared_ptr<DynamicSegment> _segment;
+
+		// Block pointers table
+		BlockTable _blocks;
+
+	}; // ChunkedArray
+}
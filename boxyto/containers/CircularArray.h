@@ -55,8 +55,9 @@ namespace Everest
 		// container should has [] operator & Size() & support iteration
 		//
 		// @param: _container - the other container to fill from
+		// @param: alloc - The elements allocator
 		template < class Container >
-		CircularArray(const Container& _container) :
+		CircularArray(const Container& _container, Allocator alloc) :
 			_capacity(_container.Size()),
 			_size(0),
 			_front(0),
@@ -0,0 +1,479 @@
+/*****************************************************************************
+The MIT License(MIT)
+
+Copyright(c) 2016 Amr Esam
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*********************************************************************************/
+#pragma once
+
+#include "../system.h"
+#include "../Template/Common.h"
+#include "../Template/Compare.h"
+#include "../memory/MemoryOps.h"
+#include "../memory/LinearAllocator.h"
+#include "Pair.h"
+#include "Array.h"
+
+namespace Everest
+{
+	// FlatMap traits, elements are Pairs keyed on first
+	template < class _Key, class _Value >
+	struct FlatMapTraits
+	{
+		typedef _Key KeyType;
+		typedef _Value Value;
+		typedef Pair<_Key, _Value> ValueType;
+
+		// Return the key of an element
+		_INLINE static const KeyType& KeyOf(const ValueType& value)
+		{
+			return value._first;
+		}
+	};
+
+	// FlatSet traits, elements are keys
+	template < class _Key >
+	struct FlatSetTraits
+	{
+		typedef _Key KeyType;
+		typedef _Key Value;
+		typedef _Key ValueType;
+
+		// Return the key of an element
+		_INLINE static const KeyType& KeyOf(const ValueType& value)
+		{
+			return value;
+		}
+	};
+
+   /*
+	* FlatContainer Class, base of FlatMap & FlatSet.
+	* Elements are kept sorted by key in a contiguous Array, lookups are binary searches,
+	* there are no nodes to allocate or to chase pointers through like the Map red-black Tree.
+	*
+	* Inserting a single element shifts the greater elements, use InsertSorted to insert many
+	* elements at once by merging, O(n + m).
+	*
+	* Elements must not be changed in a way that changes their keys order.
+	*/
+	template < class Traits, class Allocator, class Comparer >
+	class FlatContainer :
+		protected Array<typename Traits::ValueType, Allocator>
+	{
+	public:
+
+		// Typedefs
+		typedef Array<typename Traits::ValueType, Allocator> _Base;
+		typedef FlatContainer<Traits, Allocator, Comparer> _MyT;
+		typedef typename Traits::KeyType KeyType;
+		typedef typename Traits::Value Value;
+		typedef typename Traits::ValueType ValueType;
+
+		typedef typename _Base::iterator iterator;
+		typedef typename _Base::const_iterator const_iterator;
+
+		// Create an empty container
+		//
+		// @param: alloc - The allocator instance
+		FlatContainer(Allocator alloc) :
+			_Base(alloc)
+		{}
+
+		// Copy from other container constructor
+		//
+		// @param: other - Container to copy from
+		FlatContainer(_MyT& other) :
+			_Base(other)
+		{}
+
+		using _Base::Size;
+		using _Base::Capacity;
+		using _Base::Empty;
+		using _Base::Clear;
+		using _Base::Reserve;
+		using _Base::ShrinkToFit;
+		using _Base::Begin;
+		using _Base::End;
+		using _Base::cBegin;
+		using _Base::cEnd;
+		using _Base::CreateConstIterator;
+
+		// Return a const pointer to the first element, elements are sorted by key
+		_INLINE const ValueType* Data() const
+		{
+			return _Base::Data();
+		}
+
+		// Return the element at index, elements are sorted by key
+		_INLINE const ValueType& operator[](int32 index) const
+		{
+			return _Base::Data()[index];
+		}
+
+		// Return index of the first element with key not ordered before key
+		//
+		// @param: key - The key to search for
+		// @return: The index, Size() if all keys are ordered before key
+		int32 LowerBound(const KeyType& key) const
+		{
+			const ValueType* data = _Base::Data();
+			uint32 first = 0;
+			uint32 count = Size();
+			while (count > 0)
+			{
+				uint32 half = count / 2;
+				if (less(Traits::KeyOf(data[first + half]), key))
+				{
+					first += half + 1;
+					count -= half + 1;
+				}
+				else
+					count = half;
+			}
+
+			return first;
+		}
+
+		// Return index of the first element with key ordered after key
+		//
+		// @param: key - The key to search for
+		// @return: The index, Size() if no key is ordered after key
+		int32 UpperBound(const KeyType& key) const
+		{
+			const ValueType* data = _Base::Data();
+			uint32 first = 0;
+			uint32 count = Size();
+			while (count > 0)
+			{
+				uint32 half = count / 2;
+				if (!less(key, Traits::KeyOf(data[first + half])))
+				{
+					first += half + 1;
+					count -= half + 1;
+				}
+				else
+					count = half;
+			}
+
+			return first;
+		}
+
+		// Return index of the element with key
+		//
+		// @param: key - The key to find
+		// @return: Index of the first element with key, INDEX_NONE if not found
+		int32 IndexOf(const KeyType& key) const
+		{
+			int32 index = LowerBound(key);
+			if (index < (int32)Size() && !less(key, Traits::KeyOf(_Base::Data()[index])))
+				return index;
+
+			return INDEX_NONE;
+		}
+
+		// Check if the container has an element with key
+		_INLINE bool Contains(const KeyType& key) const
+		{
+			return IndexOf(key) != INDEX_NONE;
+		}
+
+		// Insert an element after elements with the same key
+		//
+		// @param: value - The element to insert
+		// @return: index of the inserted element
+		int32 Insert(const ValueType& value)
+		{
+			// Element of this container, copy it first as inserting may move it
+			if (this->Overlaps(&value))
+				return Insert(ValueType(value));
+
+			int32 index = this->InsertUninitialized(UpperBound(Traits::KeyOf(value)));
+			if (index == INDEX_NONE)
+				return INDEX_NONE; // LOG: OUT OF MEMORY
+
+			new (_Base::Data() + index) ValueType(value);
+			return index;
+		}
+
+		// Insert an element after elements with the same key
+		// Move temp
+		//
+		// @param: value - The element to insert
+		// @return: index of the inserted element
+		int32 Insert(ValueType&& value)
+		{
+			// Element of this container, move it out first as inserting may move it
+			if (this->Overlaps(&value))
+			{
+				ValueType temp(_EVEREST Move(value));
+				return Insert(_EVEREST Move(temp));
+			}
+
+			int32 index = this->InsertUninitialized(UpperBound(Traits::KeyOf(value)));
+			if (index == INDEX_NONE)
+				return INDEX_NONE; // LOG: OUT OF MEMORY
+
+			new (_Base::Data() + index) ValueType(_EVEREST Move(value));
+			return index;
+		}
+
+		// Insert an element if its key does not exist, otherwise replace the element with key
+		//
+		// @param: value - The element to insert
+		// @return: index of the inserted or replaced element
+		int32 InsertUnique(const ValueType& value)
+		{
+			int32 index = LowerBound(Traits::KeyOf(value));
+			if (index < (int32)Size() && !less(Traits::KeyOf(value), Traits::KeyOf(_Base::Data()[index])))
+			{
+				_Base::Data()[index] = value;
+				return index;
+			}
+
+			// Element of this container, copy it first as inserting may move it
+			if (this->Overlaps(&value))
+				return InsertUnique(ValueType(value));
+
+			index = this->InsertUninitialized(index);
+			if (index == INDEX_NONE)
+				return INDEX_NONE; // LOG: OUT OF MEMORY
+
+			new (_Base::Data() + index) ValueType(value);
+			return index;
+		}
+
+		// Insert an element if its key does not exist, otherwise replace the element with key
+		// Move temp
+		//
+		// @param: value - The element to insert
+		// @return: index of the inserted or replaced element
+		int32 InsertUnique(ValueType&& value)
+		{
+			int32 index = LowerBound(Traits::KeyOf(value));
+			if (index < (int32)Size() && !less(Traits::KeyOf(value), Traits::KeyOf(_Base::Data()[index])))
+			{
+				_Base::Data()[index] = _EVEREST Move(value);
+				return index;
+			}
+
+			// Element of this container, move it out first as inserting may move it
+			if (this->Overlaps(&value))
+			{
+				ValueType temp(_EVEREST Move(value));
+				return InsertUnique(_EVEREST Move(temp));
+			}
+
+			index = this->InsertUninitialized(index);
+			if (index == INDEX_NONE)
+				return INDEX_NONE; // LOG: OUT OF MEMORY
+
+			new (_Base::Data() + index) ValueType(_EVEREST Move(value));
+			return index;
+		}
+
+		// Insert many elements sorted by key at once, like InsertUnique for each element.
+		// The container grows once, then elements are merged from the back, O(n + m)
+		//
+		// @param: values - Elements sorted by key, the last element of equal keys is kept
+		// @param: count - Count of elements
+		void InsertSorted(const ValueType* values, uint32 count)
+		{
+			if (count == 0)
+				return;
+
+			// LOG: Elements of this container, adding elements may move them
+			if (this->Overlaps(values))
+				return;
+
+			const int32 size = Size();
+
+			// Count elements with new keys
+			const ValueType* data = _Base::Data();
+			uint32 added = 0;
+			int32 current = 0;
+			for (uint32 index = 0; index < count; index++)
+			{
+				const KeyType& key = Traits::KeyOf(values[index]);
+				if (index + 1 < count && !less(key, Traits::KeyOf(values[index + 1])))
+					continue; // Not the last of equal keys
+
+				while (current < size && less(Traits::KeyOf(data[current]), key))
+					current++;
+
+				if (current == size || less(key, Traits::KeyOf(data[current])))
+					added++;
+			}
+
+			if (this->AddUninitialized(added) == INDEX_NONE)
+				return; // LOG: OUT OF MEMORY
+
+			// Merge from the back, existing elements are relocated by memory copy to their final index,
+			// every index is written once
+			ValueType* dest = _Base::Data();
+			int32 last = size - 1;
+			int32 write = size + added - 1;
+			for (int32 index = count - 1; index >= 0; index--)
+			{
+				const ValueType& value = values[index];
+				const KeyType& key = Traits::KeyOf(value);
+
+				for (; last >= 0 && less(key, Traits::KeyOf(dest[last])); last--, write--)
+					if (write != last)
+						memcpy((void*)(dest + write), (const void*)(dest + last), sizeof(ValueType));
+
+				// Existing element with the same key is replaced
+				if (last >= 0 && !less(Traits::KeyOf(dest[last]), key))
+					_EVEREST Destroy(dest + last--, 1);
+
+				new (dest + write--) ValueType(value);
+
+				// Skip the other elements of equal keys, the last one is kept
+				while (index > 0 && !less(Traits::KeyOf(values[index - 1]), key))
+					index--;
+			}
+		}
+
+		// Insert all elements of an array sorted by key at once
+		//
+		// @param: values - Array of elements sorted by key, the last element of equal keys is kept
+		template < class OtherAllocator >
+		_INLINE void InsertSorted(const Array<ValueType, OtherAllocator>& values)
+		{
+			InsertSorted(values.Data(), values.Size());
+		}
+
+		// Remove the first element with key
+		//
+		// @param: key - The key to remove
+		// @return: true if removed
+		bool Remove(const KeyType& key)
+		{
+			int32 index = IndexOf(key);
+			if (index == INDEX_NONE)
+				return false;
+
+			_Base::Remove(index);
+			return true;
+		}
+
+		// Copy all keys in array, keys are sorted
+		//
+		// @param: keys - ref Array to fill with keys
+		template <typename Container>
+		void GetKeys(_out_ref_ Container& keys) const
+		{
+			keys.Reserve(Size());
+			const ValueType* data = _Base::Data();
+			for (uint32 index = 0; index < Size(); index++)
+				keys.Add(Traits::KeyOf(data[index]));
+		}
+
+	protected:
+
+		// Keys comparer
+		Comparer less;
+
+	}; // FlatContainer
+
+   /*
+	* FlatMap Class, sorted key-value Pairs in a contiguous Array.
+	* Use it for read mostly tables, see FlatContainer
+	*/
+	template < class Key,
+		class Value,
+		class Allocator = LinearAllocator<Pair<Key, Value>>,
+		class Comparer = Less<Key> >
+	class FlatMap :
+		public FlatContainer<FlatMapTraits<Key, Value>, Allocator, Comparer>
+	{
+	public:
+
+		// Typedefs
+		typedef FlatContainer<FlatMapTraits<Key, Value>, Allocator, Comparer> MyBase;
+
+		FlatMap(Allocator alloc) :
+			MyBase(alloc)
+		{}
+
+		// Find an element value at key
+		// Return pointer to found element or nullptr
+		//
+		// @param: The key to find
+		// @return: found value
+		Value* Find(const Key& key)
+		{
+			int32 index = this->IndexOf(key);
+			return index == INDEX_NONE ? nullptr : &MyBase::_Base::Data()[index]._second;
+		}
+
+		// Find an element value at key
+		// Return cosnt pointer to found element or nullptr
+		//
+		// @param: The key to find
+		// @return: found value as const
+		const Value* Find(const Key& key) const
+		{
+			int32 index = this->IndexOf(key);
+			return index == INDEX_NONE ? nullptr : &this->Data()[index]._second;
+		}
+
+		// Copy all values in array, in keys order
+		//
+		// @param: values - ref Array to fill with values
+		template <typename Container>
+		void GetValues(_out_ref_ Container& values) const
+		{
+			values.Reserve(this->Size());
+			for (uint32 index = 0; index < this->Size(); index++)
+				values.Add(this->Data()[index]._second);
+		}
+	};
+
+   /*
+	* FlatSet Class, sorted keys in a contiguous Array.
+	* Use it for read mostly sets, see FlatContainer
+	*/
+	template < class Key,
+		class Allocator = LinearAllocator<Key>,
+		class Comparer = Less<Key> >
+	class FlatSet :
+		public FlatContainer<FlatSetTraits<Key>, Allocator, Comparer>
+	{
+	public:
+
+		// Typedefs
+		typedef FlatContainer<FlatSetTraits<Key>, Allocator, Comparer> MyBase;
+
+		FlatSet(Allocator alloc) :
+			MyBase(alloc)
+		{}
+
+		// Find a key
+		//
+		// @param: The key to find
+		// @return: pointer to the found key, nullptr if not found
+		const Key* Find(const Key& key) const
+		{
+			int32 index = this->IndexOf(key);
+			return index == INDEX_NONE ? nullptr : &this->Data()[index];
+		}
+	};
+}
@@ -47,8 +47,8 @@ namespace Everest
 		typedef typename _Traits::KeyType KeyType;
 		typedef typename _Traits::Value Value;
 
-		typedef typename DoubleLinkedList<ValueType, SimpleNodeAllocator<ValueType>> BucketType;
-		typedef typename Array<BucketType, LinearAllocator<BucketType>> Buckets;
+		typedef DoubleLinkedList<ValueType, SimpleNodeAllocator<ValueType>> BucketType;
+		typedef Array<BucketType, LinearAllocator<BucketType>> Buckets;
 
 		// Init with default params
 		Hash() :
@@ -71,7 +71,8 @@ namespace Everest
 		// Init with capacity and loadFactor
 		// load factor must be in the range if .1 and 1
 		Hash(uint32 initCapacity, float loadFactor) :
-			_initCapacity(initCapacity)
+			_capacity(initCapacity),
+			_size(0)
 		{
 			_loadFactor = (loadFactor > 1.0f || loadFactor < .1f) ? .75f : loadFactor;
 			_buckets.ConstructEmpty(0, _capacity);
@@ -327,7 +328,8 @@ namespace Everest
 		// Copy all keys in array 
 		//
 		// @param: keys - ref Array to fill with keys
-		void GetKeys(_out_ref_ Array<KeyType>& keys)
+		template <typename Container>
+		void GetKeys(_out_ref_ Container& keys)
 		{
 			auto first = _buckets.CreateIterator();
 			while (first != _buckets.End()) // Buckets loop
@@ -347,7 +349,8 @@ namespace Everest
 		// Copy UNIQUE keys in array 
 		//
 		// @param: keys - ref Array to fill with keys
-		void GetUniqueKeys(_out_ref_ Array<KeyType>& keys)
+		template <typename Container>
+		void GetUniqueKeys(_out_ref_ Container& keys)
 		{
 			auto first = _buckets.CreateIterator();
 			while (first != _buckets.End()) // Buckets loop
@@ -371,7 +374,8 @@ namespace Everest
 		// Copy all values in array 
 		//
 		// @param: values - ref Array to fill with values
-		void GetValues(_out_ref_ Array<Value>& values)
+		template <typename Container>
+		void GetValues(_out_ref_ Container& values)
 		{
 			auto first = _buckets.CreateIterator();
 			while (first != _buckets.End()) // Buckets loop
@@ -392,7 +396,8 @@ namespace Everest
 		//
 		// @param: values - ref Array to fill with values
 		// @param: key - The key to match
-		void GetValues(_out_ref_ Array<Value>& values, const KeyType& key)
+		template <typename Container>
+		void GetValues(_out_ref_ Container& values, const KeyType& key)
 		{
 			int32 hash = _Hash(key) % _capacity;
 			if (_buckets.ContainIndex(hash))
@@ -27,6 +27,7 @@ SOFTWARE.
 
 #include "../system.h"
 #include "../Template/Common.h"
+#include "../Template/Compare.h"
 #include "../memory/MemoryOps.h"
 //#include "Tree.h"
 #include "Pair.h"
@@ -315,7 +316,7 @@ namespace Everest
 		typedef Pair<bool, const_reverse_iterator> rResult;
 
 		// This type
-		typedef DoubleLinkedList<T, Allocator> _MyT;
+		typedef DoubleLinkedList<T, AllocatorType> _MyT;
 
 	public:
 
@@ -338,10 +339,7 @@ namespace Everest
 		{
 			Init();
 
-			// Iterate throw container, should support iteration.
-			auto it = _container.CreateConstIterator();
-			for (; it != _container.cEnd(); ++it)
-				Add(*it);
+			Append(_container);
 		}
 
 		// Destructor
@@ -531,13 +529,13 @@ namespace Everest
 		}
 
 		// Return a reference to list head
-		_INLINE Handle& Head() const
+		_INLINE const Handle& Head() const
 		{
 			return _head;
 		}
 
 		// Return a reference to list tail
-		_INLINE Handle& Tail() const
+		_INLINE const Handle& Tail() const
 		{
 			return _tail;
 		}
@@ -548,6 +546,12 @@ namespace Everest
 			return _size;
 		}
 
+		// Return a const reference to this list allocator instance
+		_INLINE const Allocator& GetAllocator() const
+		{
+			return allocator;
+		}
+
 		// Returns reference to the first element from List
 		// Stack method
 		//
@@ -590,7 +594,8 @@ namespace Everest
 		// Stack method
 		void Pop()
 		{
-			Remove(Allocator::Parse(_tail)->GetPrev());
+			// RemoveNode, with index handles Remove(handle) would remove by element value
+			RemoveNode(Allocator::Parse(_tail)->GetPrev());
 		}
 
 		// Returns reference to the front element from List
@@ -635,36 +640,196 @@ namespace Everest
 		// Queue method
 		void Dequeue()
 		{
-			Remove(Allocator::Parse(_head)->GetPrev());
+			RemoveNode(Allocator::Parse(_head)->GetNext());
 		}
 
-		// [DEPRECATED]
-		// Allocated free, ready nodes that are sequanced and connceted
+		// Reserve count of nodes in the allocator, so the next count added nodes
+		// are allocated contiguously, in the same order they are added.
 		// This is useful if you, sometimes know how many nodes you need
 		//
-		// @param: count(1) - the count of noded to create
-		/*void Reserve(uint32 count = 1)
+		// @param: count(1) - the count of nodes to reserve
+		_INLINE void Reserve(uint32 count = 1)
+		{
+			allocator.Reserve(count);
+		}
+
+		// Appends all elements of other container at the end of the list, in order,
+		// nodes are reserved first so they are laid out in memory in traversal order.
+		// container should support iterators & Size()
+		//
+		// @param: _container - the other container to append
+		template < class Container >
+		void Append(const Container& _container)
 		{
-			if (count <= 0)
+			Reserve(_container.Size());
+
+			// Iterate throw container, should support iteration.
+			auto it = _container.CreateConstIterator();
+			for (; it != _container.cEnd(); ++it)
+				Add(*it);
+		}
+
+		// Sort the list by bottom-up merge sort, nodes are relinked in place, no node
+		// or element is allocated, copied or moved. Sort is stable, O(n log n)
+		//
+		// @param: less - Compare function, returns true if first element is ordered before second
+		template < class Compare >
+		void Sort(Compare less)
+		{
+			if (_size < 2)
 				return;
 
-			if (_tempFree.IsNull())
+			// Runs are chains of next links ending at tail, run i has 2^i nodes or is empty,
+			// a binary counter of runs merges every node log n times
+			Handle runs[32];
+			uint32 runCount = 0;
+
+			Handle node = Allocator::Parse(_head)->GetNext();
+			while (node != _tail)
 			{
-				_tempFree = EMemory::_NEW<Node>();
-				--count;
-				++_free;
+				Handle next = Allocator::Parse(node)->GetNext();
+				Allocator::Parse(node)->SetNext(_tail);
+
+				// Carry the node run up, earlier runs go first for stability
+				Handle carry = node;
+				uint32 index = 0;
+				for (; index < runCount && runs[index] != _tail; index++)
+				{
+					carry = MergeRuns(runs[index], carry, less);
+					runs[index] = _tail;
+				}
+
+				if (index == runCount)
+					runCount++;
+				runs[index] = carry;
+
+				node = next;
 			}
 
-			while (count--)
-			{
-				pointer node = EMemory::_NEW<Node>();
-				node->SetPrev(_tempFree);
-				_tempFree->SetNext(node);
-				_tempFree = node;
+			// Merge remaining runs, higher runs hold earlier nodes
+			Handle result = _tail;
+			for (uint32 index = 0; index < runCount; index++)
+				result = MergeRuns(runs[index], result, less);
 
-				++_free;
-			}
-		}*/
+			LinkRun(result);
+		}
+
+		// Sort the list in ascending order, see Sort(less)
+		_INLINE void Sort()
+		{
+			Sort(Less<ElementType>());
+		}
+
+		// Merge a sorted list into this sorted list by relinking its nodes, other list is empty after.
+		// Merge is stable, elements of this list go before equal elements of other, O(n + m)
+		//
+		// @param: other - Sorted list, its allocator must share nodes with this list allocator
+		// @param: less - Compare function both lists are sorted by
+		// @return: false if allocators do not share nodes, nothing is merged
+		template < class Compare >
+		bool Merge(DoubleLinkedList& other, Compare less)
+		{
+			if (this == &other || other._size == 0)
+				return true;
+
+			if (!allocator.Shares(other.allocator))
+				return false; // LOG: Nodes of other list can not be deallocated by this list
+
+			// Make both lists runs ending at this tail
+			Handle first = Allocator::Parse(_head)->GetNext();
+			Allocator::Parse(Allocator::Parse(_tail)->GetPrev())->SetNext(_tail);
+
+			Handle otherFirst = Allocator::Parse(other._head)->GetNext();
+			Allocator::Parse(Allocator::Parse(other._tail)->GetPrev())->SetNext(_tail);
+			other.Unlink();
+
+			LinkRun(MergeRuns(first, otherFirst, less));
+
+			_size += other._size;
+			other._size = 0;
+			return true;
+		}
+
+		// Merge a sorted list into this list in ascending order, see Merge(other, less)
+		_INLINE bool Merge(DoubleLinkedList& other)
+		{
+			return Merge(other, Less<ElementType>());
+		}
+
+		// Move a range of nodes from other list after a node of this list, in O(1).
+		// Other may be this list, after must not be in the range
+		// if after node is tail, move to end of list,
+		// if after node is head, move to front of list
+		//
+		// @param: after - Iterator to move after
+		// @param: other - The list to move from, its allocator must share nodes with this list allocator
+		// @param: first - Iterator to the first node to move
+		// @param: last - Iterator to one past the last node to move
+		// @param: count - Count of nodes in the range
+		// @return: false if allocators do not share nodes, nothing is moved
+		bool Splice(const_iterator after, DoubleLinkedList& other, const_iterator first, const_iterator last, uint32 count)
+		{
+			if (first.GetNode() == last.GetNode())
+				return true;
+
+			if (this != &other && !allocator.Shares(other.allocator))
+				return false; // LOG: Nodes of other list can not be deallocated by this list
+
+			Handle firstNode = first.GetNode();
+			Handle lastNode = Allocator::Parse(last.GetNode())->GetPrev();
+
+			// Unlink range
+			Handle prev = Allocator::Parse(firstNode)->GetPrev();
+			Allocator::Parse(prev)->SetNext(last.GetNode());
+			Allocator::Parse(last.GetNode())->SetPrev(prev);
+
+			// Link range after node
+			Handle afterNode = after.GetNode();
+			if (afterNode == _tail)
+				afterNode = Allocator::Parse(_tail)->GetPrev();
+
+			Handle next = Allocator::Parse(afterNode)->GetNext();
+			Allocator::Parse(afterNode)->SetNext(firstNode);
+			Allocator::Parse(firstNode)->SetPrev(afterNode);
+			Allocator::Parse(lastNode)->SetNext(next);
+			Allocator::Parse(next)->SetPrev(lastNode);
+
+			// Update sizes
+			other._size -= count;
+			_size += count;
+			return true;
+		}
+
+		// Move a range of nodes from other list after a node of this list.
+		// The range is counted if other is not this list, O(range)
+		//
+		// @param: after - Iterator to move after
+		// @param: other - The list to move from, its allocator must share nodes with this list allocator
+		// @param: first - Iterator to the first node to move
+		// @param: last - Iterator to one past the last node to move
+		// @return: false if allocators do not share nodes, nothing is moved
+		bool Splice(const_iterator after, DoubleLinkedList& other, const_iterator first, const_iterator last)
+		{
+			uint32 count = 0;
+			if (this != &other)
+				for (const_iterator it = first; it != last; ++it)
+					count++;
+
+			return Splice(after, other, first, last, count);
+		}
+
+		// Move all nodes of other list after a node of this list, in O(1)
+		//
+		// @param: after - Iterator to move after
+		// @param: other - The list to move from, its allocator must share nodes with this list allocator
+		// @return: false if allocators do not share nodes, nothing is moved
+		_INLINE bool Splice(const_iterator after, DoubleLinkedList& other)
+		{
+			if (this == &other)
+				return true;
+
+			return Splice(after, other, other.cBegin(), other.cEnd(), other._size);
+		}
 
 		// Return an iterator start from the begining of the list
 		//
@@ -764,6 +929,8 @@ namespace Everest
 
 			// create new node next to after node
 			Handle node = allocator.Allocate();
+			if (Allocator::Parser::IsNull(node))
+				return const_iterator(_tail); // LOG: OUT OF MEMORY
 
 			// Link node
 			Allocator::Parse(node)->ConstuctElement(element);
@@ -821,6 +988,64 @@ namespace Everest
 			allocator.Deallocate(node);
 		}
 
+		// Merge two sorted runs of next links ending at tail into one run,
+		// nodes of first go before equal nodes of second
+		//
+		// @return: first node of the merged run
+		template < class Compare >
+		Handle MergeRuns(Handle first, Handle second, Compare& less)
+		{
+			if (first == _tail)
+				return second;
+			if (second == _tail)
+				return first;
+
+			Handle result;
+			if (less(Allocator::Parse(second)->GetElement(), Allocator::Parse(first)->GetElement()))
+			{
+				result = second;
+				second = Allocator::Parse(second)->GetNext();
+			}
+			else
+			{
+				result = first;
+				first = Allocator::Parse(first)->GetNext();
+			}
+
+			Handle last = result;
+			while (first != _tail && second != _tail)
+			{
+				Handle& from = less(Allocator::Parse(second)->GetElement(), Allocator::Parse(first)->GetElement()) ? second : first;
+				Allocator::Parse(last)->SetNext(from);
+				last = from;
+				from = Allocator::Parse(from)->GetNext();
+			}
+
+			Allocator::Parse(last)->SetNext(first != _tail ? first : second);
+			return result;
+		}
+
+		// Link a run of next links ending at tail as the list nodes, sets previous links
+		_INLINE void LinkRun(Handle first)
+		{
+			Handle prev = _head;
+			for (Handle node = first; node != _tail; node = Allocator::Parse(node)->GetNext())
+			{
+				Allocator::Parse(node)->SetPrev(prev);
+				prev = node;
+			}
+
+			Allocator::Parse(_head)->SetNext(first);
+			Allocator::Parse(_tail)->SetPrev(prev);
+		}
+
+		// Link head to tail, nodes are not released
+		_INLINE void Unlink()
+		{
+			Allocator::Parse(_head)->SetNext(_tail);
+			Allocator::Parse(_tail)->SetPrev(_head);
+		}
+
 	private:
 
 		// The list head node, empty node
@@ -95,13 +95,13 @@ namespace Everest
 		}
 
 		_INLINE bool
-			operator== (const Pair& other)
+			operator== (const Pair& other) const
 		{
 			return (other._first == _first && other._second == _second);
 		}
 
 		_INLINE bool
-			operator!= (const Pair& other)
+			operator!= (const Pair& other) const
 		{
 			return (other._first != _first || other._second != _second);
 		}
@@ -34,17 +34,18 @@ SOFTWARE.
 namespace Everest
 {
 
-	//TODO: test set fucntions
+	// Set functions take an Array like c1, the result is created with c1 allocator,
+	// c2 may be any container with Contains & const iterators, like an ArrayView of c1 elements
 
 	// Set method, return the intersection between to sets
 	// ( A and B )
-	template <class Container>
+	template <class Container, class Other>
 	_INLINE Container
-		Intersection(const Container& c1, const Container& c2)
+		Intersection(const Container& c1, const Other& c2)
 	{
-		Container result;
-		auto it = c1.CreateIterator();
-		while (it != c1.End())
+		Container result(c1.GetAllocator());
+		auto it = c1.CreateConstIterator();
+		while (it != c1.cEnd())
 		{
 			if (c2.Contains(*it))
 				result.Add(*it);
@@ -57,13 +58,13 @@ namespace Everest
 
 	// Set method, return the union between to sets
 	// ( A OR B )
-	template <class Container>
+	template <class Container, class Other>
 	_INLINE Container
-		Union(const Container& c1, const Container& c2)
+		Union(const Container& c1, const Other& c2)
 	{
-		Container result;
-		auto it = c1.CreateIterator();
-		while (it != c1.End())
+		Container result(c1.GetAllocator());
+		auto it = c1.CreateConstIterator();
+		while (it != c1.cEnd())
 		{
 			if (!result.Contains(*it))
 				result.Add(*it);
@@ -71,25 +72,27 @@ namespace Everest
 			++it;
 		}
 
-		it = c2.CreateIterator();
-		while (it != c2.End())
+		auto other = c2.CreateConstIterator();
+		while (other != c2.cEnd())
 		{
-			if (!result.Contains(*it))
-				result.Add(*it);
+			if (!result.Contains(*other))
+				result.Add(*other);
 
-			++it;
+			++other;
 		}
+
+		return result;
 	}
 
 	// Set method, return the differnce (complement) between to sets
 	// ( A OR B )
-	template <class Container>
+	template <class Container, class Other>
 	_INLINE Container
-		Differnce(const Container& c1, const Container& c2)
+		Differnce(const Container& c1, const Other& c2)
 	{
-		Container result;
-		auto it = c1.CreateIterator();
-		while (it != c1.End())
+		Container result(c1.GetAllocator());
+		auto it = c1.CreateConstIterator();
+		while (it != c1.cEnd())
 		{
 			if (!c2.Contains(*it))
 				result.Add(*it);
@@ -102,19 +105,21 @@ namespace Everest
 
 	// Set method, return true if B elements all in A
 	// ( A includes B )
-	template <class Container>
+	template <class Container, class Other>
 	_INLINE bool
-		Include(const Container& c1, const Container& c2)
+		Include(const Container& c1, const Other& c2)
 	{
 		bool result = true;
-		auto it = c1.CreateIterator();
-		while (it != c1.End())
+		auto it = c2.CreateConstIterator();
+		while (it != c2.cEnd())
 		{
-			if (!c2.Contains)
+			if (!c1.Contains(*it))
 			{
 				result = false;
 				break;
 			}
+
+			++it;
 		}
 
 		return result;
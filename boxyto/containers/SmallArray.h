@@ -0,0 +1,85 @@
+/*****************************************************************************
+The MIT License(MIT)
+
+Copyright(c) 2016 Amr Esam
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*********************************************************************************/
+#pragma once
+
+#include "../system.h"
+#include "../Template/Common.h"
+#include "../memory/InlineAllocator.h"
+#include "Array.h"
+
+namespace Everest
+{
+   /*
+	* SmallArray Class, an Array that stores up to N elements inline
+	* and only allocates from the segment past N elements.
+	*
+	* Use this container for arrays that are mostly small, they cost no segment allocation,
+	* and no handle indirection while they hold N elements or less.
+	* SmallArray has all the Array methods.
+	*
+	* @param: T - Element type
+	* @param: N - Count of inline elements
+	* @param: SpillAllocator - Allocator used past N elements, LinearAllocator by default
+	*/
+	template < class T, uint32 N, class SpillAllocator = LinearAllocator<T> >
+	class SmallArray :
+		public Array<T, InlineAllocator<T, N, SpillAllocator>>
+	{
+	public:
+
+		// typedefs
+		typedef SmallArray<T, N, SpillAllocator> _MyT;
+		typedef Array<T, InlineAllocator<T, N, SpillAllocator>> _Base;
+		typedef InlineAllocator<T, N, SpillAllocator> Allocator;
+
+		// Create an empty array, with segment to use past N elements
+		//
+		// @param: segment - The segment to spill to
+		SmallArray(std::shared_ptr<DynamicSegment> segment) :
+			_Base(Allocator(segment))
+		{}
+
+		// Create the array with an initial capacity of uninitialized elements
+		//
+		// @param: capacity - the initial capacity, inline if not more than N
+		// @param: segment - The segment to spill to
+		SmallArray(const uint32 capacity, std::shared_ptr<DynamicSegment> segment) :
+			_Base(capacity, Allocator(segment))
+		{}
+
+		// Copy from other array constructor
+		//
+		// @param: other - Array to copy from
+		SmallArray(_MyT& other) :
+			_Base(other)
+		{}
+
+		// Return true if elements are stored inline
+		_INLINE bool IsInline() const
+		{
+			return _Base::GetAllocator().IsInline();
+		}
+	};
+}
@@ -0,0 +1,444 @@
+/*****************************************************************************
+The MIT License(MIT)
+
+Copyright(c) 2016 Amr Esam
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*********************************************************************************/
+#pragma once
+
+#include "../system.h"
+#include "../Template/Common.h"
+#include "../memory/MemoryOps.h"
+#include "../memory/LinearAllocator.h"
+#include "Array.h"
+
+namespace Everest
+{
+	// Per column operations for SoaArray, recursive over the fields list
+	// Column I starts at offsets[I] bytes from the block
+	template < uint32 I, class... Fields >
+	struct SoaColumns
+	{
+		_INLINE static void Layout(SIZE_T* offsets, uint32 capacity, SIZE_T alignment, SIZE_T& bytes) {}
+		_INLINE static void Construct(ubyte* block, const SIZE_T* offsets, uint32 index) {}
+		_INLINE static void CopyRange(ubyte* block, const SIZE_T* offsets, const ubyte* source, const SIZE_T* sourceOffsets, uint32 count) {}
+		_INLINE static void Destroy(ubyte* block, const SIZE_T* offsets, uint32 index, uint32 count) {}
+		_INLINE static void ShiftBackward(ubyte* block, const SIZE_T* offsets, uint32 index, uint32 count, uint32 size) {}
+		_INLINE static void Relocate(ubyte* block, const SIZE_T* oldOffsets, const SIZE_T* newOffsets, uint32 size) {}
+		_INLINE static void Swap(ubyte* block, const SIZE_T* offsets, uint32 first, uint32 second) {}
+	};
+
+	template < uint32 I, class F, class... Rest >
+	struct SoaColumns<I, F, Rest...>
+	{
+		typedef SoaColumns<I + 1, Rest...> Next;
+
+		// Return column I
+		_INLINE static F* Column(ubyte* block, const SIZE_T* offsets)
+		{
+			return (F*)(block + offsets[I]);
+		}
+
+		// Calculate column offsets for capacity, each column starts at an aligned offset
+		static void Layout(SIZE_T* offsets, uint32 capacity, SIZE_T alignment, SIZE_T& bytes)
+		{
+			SIZE_T align = alignof(F) > alignment ? alignof(F) : alignment;
+			offsets[I] = (bytes + align - 1) & ~(align - 1);
+			bytes = offsets[I] + sizeof(F) * capacity;
+			Next::Layout(offsets, capacity, alignment, bytes);
+		}
+
+		// Construct element at index in each column, from a value per column
+		template < class A, class... Args >
+		static void Construct(ubyte* block, const SIZE_T* offsets, uint32 index, A&& value, Args&&... rest)
+		{
+			new (Column(block, offsets) + index) F(_EVEREST Forward<A>(value));
+			Next::Construct(block, offsets, index, _EVEREST Forward<Args>(rest)...);
+		}
+
+		// Copy construct count elements of each column from source columns
+		static void CopyRange(ubyte* block, const SIZE_T* offsets, const ubyte* source, const SIZE_T* sourceOffsets, uint32 count)
+		{
+			ConstructRangeFromRange((const F*)(source + sourceOffsets[I]), Column(block, offsets), count);
+			Next::CopyRange(block, offsets, source, sourceOffsets, count);
+		}
+
+		// Destroy count of elements start from index in each column
+		static void Destroy(ubyte* block, const SIZE_T* offsets, uint32 index, uint32 count)
+		{
+			_EVEREST Destroy(Column(block, offsets) + index, count);
+			Next::Destroy(block, offsets, index, count);
+		}
+
+		// Move elements after index + count back by count in each column
+		static void ShiftBackward(ubyte* block, const SIZE_T* offsets, uint32 index, uint32 count, uint32 size)
+		{
+			F* column = Column(block, offsets);
+			Memmove(column + index, column + index + count, sizeof(F) * (size - index - count));
+			Next::ShiftBackward(block, offsets, index, count, size);
+		}
+
+		// Move columns from old offsets to new (bigger) offsets,
+		// later columns are moved first so no column overwrites one not moved yet
+		static void Relocate(ubyte* block, const SIZE_T* oldOffsets, const SIZE_T* newOffsets, uint32 size)
+		{
+			Next::Relocate(block, oldOffsets, newOffsets, size);
+			if (oldOffsets[I] != newOffsets[I])
+				Memmove(block + newOffsets[I], block + oldOffsets[I], sizeof(F) * size);
+		}
+
+		// Swap two elements in each column
+		static void Swap(ubyte* block, const SIZE_T* offsets, uint32 first, uint32 second)
+		{
+			F* column = Column(block, offsets);
+			F temp = _EVEREST Move(column[first]);
+			column[first] = _EVEREST Move(column[second]);
+			column[second] = _EVEREST Move(temp);
+			Next::Swap(block, offsets, first, second);
+		}
+	};
+
+   /*
+	* SoaArray Class, a structure of arrays container.
+	* Each field is stored in its own column, columns are aligned to a cache line
+	* and allocated together in a single LinearAllocator block.
+	*
+	* Loops that only touch some fields load only their columns,
+	* instead of whole elements as with an Array of structs.
+	* When growing, the block is reallocated and columns are re-laid for the new capacity,
+	* elements are relocated by memory move, just like Array elements.
+	*
+	* @param: Fields - Column types, field I is accessed by Get<I>, Column<I> and Begin<I>
+	*/
+	template < class... Fields >
+	class SoaArray
+	{
+		// Allocation unit, a cache line, so the block is cache line aligned
+		struct alignas(64) Line
+		{
+			ubyte bytes[64];
+		};
+
+		typedef SoaColumns<0, Fields...> Columns;
+
+	public:
+
+		// typedefs
+		typedef SoaArray<Fields...> _MyT;
+		typedef LinearAllocator<Line> Allocator;
+
+		// Type of field I
+		template < uint32 I >
+		struct Field
+		{
+			typedef typename TypeAt<I, Fields...>::Type Type;
+			typedef linearIterator<Type> iterator;
+			typedef linearIterator<const Type> const_iterator;
+		};
+
+		// Count of fields
+		enum { FIELD_COUNT = sizeof...(Fields) };
+
+		// Alignment of each column
+		enum { COLUMN_ALIGNMENT = sizeof(Line) };
+
+		// Delete default constructor
+		SoaArray() = delete;
+
+		// Create an array with initial capacity
+		//
+		// @param: segment - The segment to allocate from
+		// @param: capacity(DEFAULT_CONTAINER_CAPACITY) - the initial capacity
+		SoaArray(std::shared_ptr<DynamicSegment> segment, uint32 capacity = DEFAULT_CONTAINER_CAPACITY) :
+			_size(0),
+			_capacity(capacity ? capacity : 1),
+			_allocator(segment, LineCount(capacity ? capacity : 1, _offsets))
+		{
+			_allocator.Init();
+		}
+
+		// Copy from other array constructor
+		//
+		// @param: other - Array to copy from
+		SoaArray(const _MyT& other) :
+			_size(other._size),
+			_capacity(other._size ? other._size : 1),
+			_allocator(other.GetSegmentManager(), LineCount(other._size ? other._size : 1, _offsets))
+		{
+			_allocator.Init();
+			Columns::CopyRange(Block(), _offsets, other.Block(), other._offsets, _size);
+		}
+
+		// Destruct all elements and free the columns block
+		~SoaArray()
+		{
+			Clear();
+			_allocator.Release();
+		}
+
+		// Copy this array from other array, into this array own block
+		//
+		// @param: other - array to copy from
+		// @return: reference to this array
+		_INLINE _MyT& operator=(const _MyT& other)
+		{
+			if (this != &other)
+			{
+				Clear();
+				if (!Reserve(other._size))
+					return *this; // LOG: OUT OF MEMORY
+
+				Columns::CopyRange(Block(), _offsets, other.Block(), other._offsets, other._size);
+				_size = other._size;
+			}
+			return *this;
+		}
+
+		// Add an element, a value for each field
+		//
+		// @param: values - Field values to copy
+		// @return: index of the added element, INDEX_NONE if out of memory
+		int32 Add(const Fields&... values)
+		{
+			if (!Ensure(1))
+				return INDEX_NONE;
+
+			Columns::Construct(Block(), _offsets, _size, values...);
+			return _size++;
+		}
+
+		// Add an element, a value for each field
+		//
+		// @param: values - Field values to move
+		// @return: index of the added element, INDEX_NONE if out of memory
+		int32 Add(Fields&&... values)
+		{
+			if (!Ensure(1))
+				return INDEX_NONE;
+
+			Columns::Construct(Block(), _offsets, _size, _EVEREST Move(values)...);
+			return _size++;
+		}
+
+		// Add default constructed elements
+		//
+		// @param: count(1) - count of elements to add
+		// @return: index of the first added element, INDEX_NONE if out of memory
+		int32 AddDefault(uint32 count = 1)
+		{
+			if (!Ensure(count))
+				return INDEX_NONE;
+
+			int32 index = _size;
+			while (count--)
+				Columns::Construct(Block(), _offsets, _size++, Fields()...);
+
+			return index;
+		}
+
+		// Remove element or more from this array,
+		// this method also destruct removed element(s)
+		//
+		// @param: index - start index to remove from
+		// @param: count(1) - count of elements to remove
+		void Remove(const int32 index, const int32 count = 1)
+		{
+			// Check if index & count exists
+			if (index < 0 || index >= _size || count > _size - index)
+				return;
+
+			Columns::Destroy(Block(), _offsets, index, count);
+
+			// Last elements removed, no need to shift elements
+			if (index + count != _size)
+				Columns::ShiftBackward(Block(), _offsets, index, count, _size);
+
+			_size -= count;
+		}
+
+		// Swap two elements at given indecies
+		//
+		// @param: first - first element to swap
+		// @param: second - element to swap with first
+		void Swap(uint32 first, uint32 second)
+		{
+			if (first != second)
+				Columns::Swap(Block(), _offsets, first, second);
+		}
+
+		// Destroy all elements, capacity is not changed
+		void Clear()
+		{
+			Columns::Destroy(Block(), _offsets, 0, _size);
+			_size = 0;
+		}
+
+		// Reserve capacity for count of elements, re-lay columns if required
+		//
+		// @param: count - capacity required
+		// @return: false if out of memory
+		bool Reserve(uint32 count)
+		{
+			if (count <= (uint32)_capacity)
+				return true;
+
+			SIZE_T offsets[FIELD_COUNT];
+			uint32 lines = LineCount(count, offsets);
+
+			if (!_allocator.Reserve(lines))
+				return false; // LOG: OUT OF MEMORY
+
+			Columns::Relocate(Block(), _offsets, offsets, _size);
+			Memcopy(_offsets, offsets, sizeof(offsets));
+			_capacity = count;
+
+			return true;
+		}
+
+		// Make sure there is room for count of elements more, grow by half if required
+		//
+		// @param: count - count of elements to add
+		// @return: false if out of memory
+		_INLINE bool Ensure(uint32 count)
+		{
+			if (_size + count <= (uint32)_capacity)
+				return true;
+
+			return Reserve(GrowthHalf::Grow(_capacity, _size + count));
+		}
+
+		// Return a pointer to the first element of field I
+		template < uint32 I >
+		_INLINE typename Field<I>::Type* Column()
+		{
+			return (typename Field<I>::Type*)(Block() + _offsets[I]);
+		}
+
+		// Return a const pointer to the first element of field I
+		template < uint32 I >
+		_INLINE const typename Field<I>::Type* Column() const
+		{
+			return (const typename Field<I>::Type*)(Block() + _offsets[I]);
+		}
+
+		// Return field I of element at index
+		template < uint32 I >
+		_INLINE typename Field<I>::Type& Get(int32 index)
+		{
+			return Column<I>()[index];
+		}
+
+		// Return field I of element at index
+		template < uint32 I >
+		_INLINE const typename Field<I>::Type& Get(int32 index) const
+		{
+			return Column<I>()[index];
+		}
+
+		// Return an iterator of field I, start from some index
+		//
+		// @param: start - index to start element
+		// @return: Iterator to field I of element at index start
+		template < uint32 I >
+		typename Field<I>::iterator CreateIterator(uint32 start = 0)
+		{
+			return typename Field<I>::iterator(Column<I>() + start, start);
+		}
+
+		// Returns an iterator to the begin of field I
+		template < uint32 I >
+		typename Field<I>::iterator Begin()
+		{
+			return typename Field<I>::iterator(Column<I>(), 0);
+		}
+
+		// Returns a const iterator to the begin of field I
+		template < uint32 I >
+		typename Field<I>::const_iterator cBegin() const
+		{
+			return typename Field<I>::const_iterator(Column<I>(), 0);
+		}
+
+		// Returns an iterator to the end of field I
+		template < uint32 I >
+		typename Field<I>::iterator End()
+		{
+			return typename Field<I>::iterator(Column<I>() + _size, _size);
+		}
+
+		// Returns a const iterator to the end of field I
+		template < uint32 I >
+		typename Field<I>::const_iterator cEnd() const
+		{
+			return typename Field<I>::const_iterator(Column<I>() + _size, _size);
+		}
+
+		// Get Segment manager used by this array
+		_INLINE std::shared_ptr<DynamicSegment> GetSegmentManager() const
+		{
+			return _allocator.GetSegmentManager();
+		}
+
+		// Returns true if the array is empty
+		_INLINE bool Empty() const { return _size == 0; }
+
+		// Returns the array capacity
+		_INLINE uint32 Capacity() const { return _capacity; }
+
+		// Returns the actual size of the array
+		_INLINE uint32 Size() const { return _size; }
+
+	private:
+
+		// Return the block start
+		_INLINE ubyte* Block() const
+		{
+			return (ubyte*)_allocator.Get().Get();
+		}
+
+		// Calculate column offsets for capacity
+		//
+		// @param: capacity - count of elements in each column
+		// @param: offsets - column offsets to fill
+		// @return: count of lines to allocate
+		static uint32 LineCount(uint32 capacity, SIZE_T* offsets)
+		{
+			SIZE_T bytes = 0;
+			Columns::Layout(offsets, capacity, COLUMN_ALIGNMENT, bytes);
+			return (uint32)((bytes + sizeof(Line) - 1) / sizeof(Line));
+		}
+
+	private:
+
+		// Array actual size
+		int32 _size;
+
+		// Elements capacity of each column
+		int32 _capacity;
+
+		// Byte offset of each column in the block
+		SIZE_T _offsets[FIELD_COUNT];
+
+		// Allocator of the block
+		Allocator _allocator;
+
+	}; // SoaArray
+}
@@ -0,0 +1,256 @@
+/*****************************************************************************
+The MIT License(MIT)
+
+Copyright(c) 2016 Amr Esam
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*********************************************************************************/
+#pragma once
+
+#include "../system.h"
+#include "../Template/Common.h"
+#include "../Template/Compare.h"
+#include "../memory/DynamicSegment.h"
+#include "../memory/LinearAllocator.h"
+#include "Array.h"
+
+#include <memory>
+
+// Prefetch hint for the search, a no-op where no prefetch instruction is known
+#if defined(_M_X64) || defined(__x86_64__) || defined(_M_IX86) || defined(__i386__)
+#include <xmmintrin.h>
+#define SEARCH_PREFETCH(address) _mm_prefetch((const char*)(address), _MM_HINT_T0)
+#elif defined(__GNUC__)
+#define SEARCH_PREFETCH(address) __builtin_prefetch((const void*)(address))
+#else
+#define SEARCH_PREFETCH(address)
+#endif
+
+namespace Everest
+{
+	// Cache line size the search prefetches by
+	constexpr uint32 SEARCH_CACHE_LINE = 64;
+
+   /*
+	* StaticSearchIndex Class, a read only search index over sorted keys.
+	*
+	* Keys are stored in Eytzinger (BFS) layout, the children of position k are at 2k and 2k+1,
+	* position 0 is padding. The first levels of the search share a few cache lines, and all
+	* the descendants of a position a few levels below it are contiguous, so they are prefetched
+	* while the current levels are compared. A binary search over a large sorted Array misses
+	* the cache at almost every level instead.
+	*
+	* The search loop has no data dependent branch, each level picks a child by the comparison
+	* result. Results are ranks, the indices in the sorted keys the index was built from,
+	* use them to index any Array of values kept in the same order.
+	*
+	* Build is O(n), rebuild the index when the keys change.
+	*
+	* @param: T - Key type
+	* @param: Comparer(Less<T>) - Keys order, the sorted keys must be ordered by it
+	*/
+	template < class T, class Comparer = Less<T> >
+	class StaticSearchIndex
+	{
+		typedef Array<T, LinearAllocator<T>> KeyTable;
+		typedef Array<uint32, LinearAllocator<uint32>> RankTable;
+
+	public:
+
+		// typedefs
+		typedef StaticSearchIndex<T, Comparer> _MyT;
+		typedef T KeyType;
+
+		// Keys per cache line, the search prefetches log2(PREFETCH_STRIDE) levels ahead
+		enum { PREFETCH_STRIDE = sizeof(T) < SEARCH_CACHE_LINE ? SEARCH_CACHE_LINE / sizeof(T) : 1 };
+
+		// Delete default constructor
+		StaticSearchIndex() = delete;
+
+		// Create an empty index
+		//
+		// @param: segment - The segment to allocate keys & ranks from
+		StaticSearchIndex(std::shared_ptr<DynamicSegment> segment) :
+			_size(0),
+			_keys(LinearAllocator<T>(segment, DEFAULT_CONTAINER_CAPACITY)),
+			_ranks(LinearAllocator<uint32>(segment, DEFAULT_CONTAINER_CAPACITY))
+		{}
+
+		// Create an index of sorted keys
+		//
+		// @param: sorted - Array of keys sorted by Comparer
+		// @param: segment - The segment to allocate keys & ranks from
+		template < class Allocator >
+		StaticSearchIndex(const Array<T, Allocator>& sorted, std::shared_ptr<DynamicSegment> segment) :
+			StaticSearchIndex(segment)
+		{
+			Build(sorted);
+		}
+
+		// Build the index of sorted keys, replaces the current keys
+		//
+		// @param: sorted - Keys sorted by Comparer
+		// @param: count - Count of keys
+		void Build(const T* sorted, uint32 count)
+		{
+			_keys.Clear();
+			_ranks.Clear();
+			_size = count;
+			if (count == 0)
+				return;
+
+			_keys.Ensure(count + 1);
+			_ranks.Ensure(count + 1);
+
+			// Ranks of positions by in order traversal, then keys in position order
+			for (uint32 position = 0; position <= count; position++)
+				_ranks.Add(0);
+
+			FillRanks(_ranks.Data(), 0, 1);
+
+			for (uint32 position = 0; position <= count; position++)
+				_keys.Add(sorted[_ranks.Data()[position]]);
+
+			// Search ends at position 0 when no key follows
+			_ranks.Data()[0] = count;
+		}
+
+		// Build the index of sorted keys, replaces the current keys
+		//
+		// @param: sorted - Array of keys sorted by Comparer
+		template < class Allocator >
+		_INLINE void Build(const Array<T, Allocator>& sorted)
+		{
+			Build(sorted.Data(), sorted.Size());
+		}
+
+		// Return rank of the first key not ordered before key
+		//
+		// @param: key - The key to search for
+		// @return: rank, Size() if all keys are ordered before key
+		_INLINE uint32 LowerBound(const T& key) const
+		{
+			return _size == 0 ? 0 : _ranks.Data()[Search<false>(key)];
+		}
+
+		// Return rank of the first key ordered after key
+		//
+		// @param: key - The key to search for
+		// @return: rank, Size() if no key is ordered after key
+		_INLINE uint32 UpperBound(const T& key) const
+		{
+			return _size == 0 ? 0 : _ranks.Data()[Search<true>(key)];
+		}
+
+		// Find a key
+		//
+		// @param: key - The key to find
+		// @return: rank of the first equal key, INDEX_NONE if not found
+		int32 IndexOf(const T& key) const
+		{
+			if (_size == 0)
+				return INDEX_NONE;
+
+			uint32 position = Search<false>(key);
+			if (position == 0 || less(key, _keys.Data()[position]))
+				return INDEX_NONE;
+
+			return _ranks.Data()[position];
+		}
+
+		// Check if the index has a key
+		_INLINE bool Contains(const T& key) const
+		{
+			return IndexOf(key) != INDEX_NONE;
+		}
+
+		// Return the count of keys
+		_INLINE uint32 Size() const
+		{
+			return _size;
+		}
+
+		// Check if the index has no keys
+		_INLINE bool Empty() const
+		{
+			return _size == 0;
+		}
+
+		// Remove all keys and free memory
+		void Release()
+		{
+			_keys.Release();
+			_ranks.Release();
+			_size = 0;
+		}
+
+	private:
+
+		// Set ranks of the subtree at position by in order traversal
+		//
+		// @param: ranks - Ranks by position
+		// @param: rank - Rank of the first key of the subtree
+		// @param: position - Subtree root position
+		// @return: rank after the subtree
+		uint32 FillRanks(uint32* ranks, uint32 rank, uint32 position)
+		{
+			if (position > _size)
+				return rank;
+
+			rank = FillRanks(ranks, rank, 2 * position);
+			ranks[position] = rank++;
+			return FillRanks(ranks, rank, 2 * position + 1);
+		}
+
+		// Branchless descent, returns position of the first key not ordered before key,
+		// or ordered after key if UPPER, 0 if none
+		template < bool UPPER >
+		uint32 Search(const T& key) const
+		{
+			const T* keys = _keys.Data();
+			const UINTPTR base = (UINTPTR)keys;
+			uint32 position = 1;
+			uint32 found = 0;
+			while (position <= _size)
+			{
+				// The 16 descendants 4 levels down (for 4 byte keys) share a cache line, address may be past the keys
+				SEARCH_PREFETCH(base + (UINTPTR)position * PREFETCH_STRIDE * sizeof(T));
+
+				const uint32 right = UPPER ? !less(key, keys[position]) : less(keys[position], key);
+				found = right ? found : position;
+				position = 2 * position + right;
+			}
+
+			return found;
+		}
+
+		// Count of keys
+		uint32 _size;
+
+		// Keys by position, position 0 is padding
+		KeyTable _keys;
+
+		// Sorted ranks by position
+		RankTable _ranks;
+
+		// Keys comparer
+		Comparer less;
+	};
+}
@@ -257,8 +257,8 @@ namespace Everest
 	template< class ValueType, class Parser >
 	struct Node_RB
 	{
-		typedef typename Node_RB<ValueType, Parser> type;
-		typedef typename NodePointer<Parser, type> Pointer;
+		typedef Node_RB<ValueType, Parser> type;
+		typedef NodePointer<Parser, type> Pointer;
 
 		Pointer _parent; // This node parent
 		Pointer _right; // The left node, larger
@@ -287,11 +287,11 @@ namespace Everest
 		typedef typename _Traits::Value Value;
 
 		typedef typename AllocatorType::Parser Parser;
-		typedef typename Node_RB<ValueType, Parser> Node;
+		typedef Node_RB<ValueType, Parser> Node;
 		typedef typename AllocatorType::template Rebind<Node>::Other Allocator;
 		typedef typename Node::Pointer NodePointer;
 
-		typedef Tree<_Traits, Allocator> _MyT;
+		typedef Tree<_Traits, AllocatorType> _MyT;
 
 		typedef TreeIterator<Tree<_Traits, AllocatorType>> iterator;
 		typedef TreeReverseIterator<_MyT> reverse_iterator;
@@ -336,12 +336,25 @@ namespace Everest
 			Append(_EVEREST Move(other));
 		}
 
-		// Construct from range
-		//Tree(Iterator first, Iterator last)
-		//{
-		//	while (first != last)
-		//		Insert(*first++)
-		//}
+		// Construct by coping from other container,
+		// container should support iterators & Size()
+		//
+		// @param: container - the other container to fill from
+		// @param: alloc - The allocator instance
+		template <class Container>
+		Tree(const Container& container, Allocator alloc) :
+			allocator(alloc),
+			_size(0)
+		{
+			_Init();
+
+			// Nodes are allocated in the container order
+			Reserve(container.Size());
+
+			auto it = container.CreateConstIterator();
+			for (; it != container.cEnd(); ++it)
+				Insert(ValueType(*it));
+		}
 
 		// Destructor
 		~Tree()
@@ -369,6 +382,9 @@ namespace Everest
 		_INLINE NodePointer Insert(ValueType&& value)
 		{
 			NodePointer node = allocator.Allocate();
+			if (node.IsNull())
+				return node; // LOG: OUT OF MEMORY
+
 			new(&node->_value) ValueType(_EVEREST Move(value));
 			_Insert(node, _root);
 			return node;
@@ -441,9 +457,14 @@ namespace Everest
 		// @param: other - the other tree
 		void Append(const _MyT& other)
 		{
-			auto it = other.Begin();
-			for (; it != other.End(); ++it)
-				Insert(*it);
+			Reserve(other._size);
+
+			// Iterators walk the tree through a non const pointer, other is only read
+			_MyT& source = const_cast<_MyT&>(other);
+
+			auto it = source.Begin();
+			for (; it != source.End(); ++it)
+				Insert(ValueType(*it));
 		}
 
 		// Appends other tree to this tree
@@ -452,6 +473,8 @@ namespace Everest
 		// @param: other - the other tree
 		void Append(_MyT&& other)
 		{
+			Reserve(other._size);
+
 			auto it = other.Begin();
 			for (; it != other.End(); ++it)
 				Insert(_EVEREST Move(*it));
@@ -459,6 +482,16 @@ namespace Everest
 			other.Clear();
 		}
 
+		// Reserve count of nodes in the allocator, so the next count inserted nodes
+		// are allocated contiguously, in the same order they are inserted.
+		// Inserting sorted values after Reserve lays the nodes out in traversal order
+		//
+		// @param: count - the count of nodes to reserve
+		_INLINE void Reserve(uint32 count)
+		{
+			allocator.Reserve(count);
+		}
+
 		/*_MyT& operator= (const _MyT& right)
 		{
 			if (&right != this)
@@ -517,9 +550,9 @@ namespace Everest
 			if (y->_color == TREE_COLOR_BLACK)
 				_RemoveFix(x);
 
-			// free deleted node
-			(z->_value).~ValueType();
-			allocator.Deallocate(z.GetHandle());
+			// free the unlinked node, z took its value if they differ
+			(y->_value).~ValueType();
+			allocator.Deallocate(y.GetHandle());
 			--_size;
 		}
 
@@ -641,7 +674,13 @@ namespace Everest
 		}
 
 		// Return a referece to this container allocator instance
-		Allocator& GetAllocator() const
+		_INLINE Allocator& GetAllocator()
+		{
+			return allocator;
+		}
+
+		// Return a const referece to this container allocator instance
+		_INLINE const Allocator& GetAllocator() const
 		{
 			return allocator;
 		}
@@ -654,7 +693,7 @@ namespace Everest
 		}
 
 		// Return the size of the tree
-		_INLINE uint32 Size()
+		_INLINE uint32 Size() const
 		{
 			return _size;
 		}
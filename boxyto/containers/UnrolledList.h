@@ -0,0 +1,833 @@
+/*****************************************************************************
+The MIT License(MIT)
+
+Copyright(c) 2016 Amr Esam
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*********************************************************************************/
+#pragma once
+
+#include "../system.h"
+#include "../Template/Common.h"
+#include "../memory/MemoryOps.h"
+#include "../memory/PoolNodeAllocator.h"
+#include "../algorithms/Find.h"
+#include "Pair.h"
+
+/* For std::shared_ptr */
+#include <memory>
+
+namespace Everest
+{
+	// UnrolledList node, holds up to K elements and links to the next & previous nodes
+	template < class T, uint32 K, class HandleType >
+	class UnrolledListNode
+	{
+	public:
+
+		// Typedefs
+		typedef UnrolledListNode<T, K, HandleType> Node;
+		typedef T ElementType;
+		typedef HandleType Handle;
+
+		// Delete default constructor
+		UnrolledListNode() = default;
+
+		// Initialize an allocated node, with no elements
+		_INLINE void Init(const Handle& previous, const Handle& next)
+		{
+			_previous = previous;
+			_next = next;
+			_count = 0;
+		}
+
+		// Retrun the next node handle
+		_INLINE Handle GetNext() const
+		{
+			return _next;
+		}
+
+		// Return the previous node handle
+		_INLINE Handle GetPrev() const
+		{
+			return _previous;
+		}
+
+		// Set the next node handle
+		_INLINE void SetNext(const Handle& _other)
+		{
+			_next = _other;
+		}
+
+		// Set the previous node handle
+		_INLINE void SetPrev(const Handle& _other)
+		{
+			_previous = _other;
+		}
+
+		// Return count of elements in the node
+		_INLINE uint32 Count() const
+		{
+			return _count;
+		}
+
+		// Set count of elements in the node, elements must be constructed or relocated first
+		_INLINE void SetCount(uint32 count)
+		{
+			_count = count;
+		}
+
+		// Return pointer to the first element
+		_INLINE ElementType* Elements()
+		{
+			return reinterpret_cast<ElementType*>(_elements);
+		}
+
+		// Return const pointer to the first element
+		_INLINE const ElementType* Elements() const
+		{
+			return reinterpret_cast<const ElementType*>(_elements);
+		}
+
+		// Return a reference to the element at index
+		_INLINE ElementType& GetElement(uint32 index)
+		{
+			return Elements()[index];
+		}
+
+		// Return a const reference to the element at index
+		_INLINE const ElementType& GetElement(uint32 index) const
+		{
+			return Elements()[index];
+		}
+
+		// Move elements from index up by one, the element at index is uninitialized
+		_INLINE void OpenGap(uint32 index)
+		{
+			Memmove(Elements() + index + 1, Elements() + index, (_count - index) * sizeof(ElementType));
+			_count++;
+		}
+
+		// Destroy the element at index and move the next elements down by one
+		_INLINE void Erase(uint32 index)
+		{
+			_EVEREST Destroy(Elements() + index, 1);
+			Memmove(Elements() + index, Elements() + index + 1, (_count - index - 1) * sizeof(ElementType));
+			_count--;
+		}
+
+	private:
+
+		Handle _next, _previous;
+
+		// Count of constructed elements
+		uint32 _count;
+
+		// Elements storage
+		alignas(ElementType) ubyte _elements[K * sizeof(ElementType)];
+
+	}; // UnrolledListNode
+
+	template < class T, class AllocatorType >
+	class UnrolledListIterator
+	{
+	public:
+
+		// Typedefs
+		typedef UnrolledListIterator _MyT;
+		typedef T Element;
+
+		typedef typename AllocatorType::Handle Handle;
+
+		UnrolledListIterator(Handle node, uint32 index) :
+			_Current(node),
+			_Index(index)
+		{}
+
+		_MyT operator++(int junk)
+		{
+			_MyT _Tmp = *this;
+			++*this;
+			return _Tmp;
+		}
+
+		_MyT& operator++()
+		{
+			if (++_Index == AllocatorType::Parse(_Current)->Count())
+			{
+				_Current = AllocatorType::Parse(_Current)->GetNext();
+				_Index = 0;
+			}
+			return *this;
+		}
+
+		_MyT operator--(int junk)
+		{
+			_MyT _Tmp = *this;
+			--*this;
+			return _Tmp;
+		}
+
+		_MyT& operator--()
+		{
+			if (_Index == 0)
+			{
+				_Current = AllocatorType::Parse(_Current)->GetPrev();
+				_Index = AllocatorType::Parse(_Current)->Count();
+			}
+			--_Index;
+			return *this;
+		}
+
+		Element& operator*()
+		{
+			return AllocatorType::Parse(_Current)->GetElement(_Index);
+		}
+
+		const Element& operator*() const
+		{
+			return AllocatorType::Parse(_Current)->GetElement(_Index);
+		}
+
+		Element* operator->()
+		{
+			return &(AllocatorType::Parse(_Current)->GetElement(_Index));
+		}
+
+		bool operator==(const _MyT& other) const
+		{
+			return _Index == other._Index && _Current == other._Current;
+		}
+
+		bool operator!=(const _MyT& other) const
+		{
+			return _Index != other._Index || _Current != other._Current;
+		}
+
+		_INLINE Handle GetNode() const
+		{
+			return _Current;
+		}
+
+		_INLINE uint32 GetIndex() const
+		{
+			return _Index;
+		}
+
+	private:
+		Handle _Current;
+		uint32 _Index;
+	}; // UnrolledListIterator
+
+   /*
+	* UnrolledList Class, a double linked list of nodes holding up to K elements each.
+	*
+	* Elements of a node are contiguous, iterating takes a pointer chase per K elements
+	* instead of per element, and node links & allocation overhead are shared by K elements.
+	* A full node is split in half to insert, a node under half full after a removal takes
+	* elements from the next node or merges with it.
+	*
+	* Elements are relocated by memory copy inside & between nodes, just like Array elements.
+	* Inserting or removing invalidates iterators & references to elements of the changed nodes.
+	*
+	* @param: T - Element type
+	* @param: K(16) - Elements count per node
+	* @param: AllocatorType(PoolNodeAllocator) - Nodes allocator, rebound to the node type,
+	*		its capacity is a count of nodes
+	*/
+	template < class T, uint32 K = 16, class AllocatorType = PoolNodeAllocator<T> >
+	class UnrolledList
+	{
+	public:
+
+		// Typedefs
+
+		typedef T ElementType;
+
+		// Typedef handle type from the allocator type
+		typedef typename AllocatorType::Handle Handle;
+
+		// Node type
+		typedef UnrolledListNode< ElementType, K, Handle > Node;
+
+		// Rebind allocator type
+		typedef typename AllocatorType::template Rebind<Node>::Other Allocator;
+
+		typedef UnrolledListIterator < ElementType, Allocator > iterator;
+		typedef UnrolledListIterator < ElementType, Allocator > const_iterator;
+
+		// Find results defs
+		typedef Pair<bool, const_iterator> Result;
+
+		// This type
+		typedef UnrolledList<T, K, Allocator> _MyT;
+
+		// Elements count per node
+		enum { NODE_CAPACITY = K };
+
+	public:
+
+		// Default constructor
+		UnrolledList(Allocator alloc) :
+			_size(0),
+			_nodes(0),
+			allocator(alloc)
+		{
+			Init();
+		};
+
+		// Initialize this list by coping from other container,
+		// container should support iterators
+		//
+		// @param: _container - the other container to fill from
+		template < class Container >
+		UnrolledList(const Container& _container, Allocator alloc) :
+			_size(0),
+			_nodes(0),
+			allocator(alloc)
+		{
+			Init();
+
+			Append(_container);
+		}
+
+		// Destructor
+		~UnrolledList()
+		{
+			Clear();
+
+			allocator.Deallocate(_head);
+			allocator.Deallocate(_tail);
+		}
+
+		// Adds element to the front of the list
+		//
+		// @param: element - reference to element to add
+		// @return: Iterator to inserted location
+		const_iterator AddFront(const ElementType& element)
+		{
+			return _Insert(FrontNode(), 0, element);
+		}
+
+		// Adds element to the front of the list
+		// Move temp
+		//
+		// @param: element - reference to element to add
+		// @return: Iterator to inserted location
+		const_iterator AddFront(ElementType&& element)
+		{
+			return _Insert(FrontNode(), 0, _EVEREST Move(element));
+		}
+
+		// Adds element to the end of the list
+		//
+		// @param: element - reference to element to add
+		// @return: Iterator to inserted location
+		const_iterator Add(const ElementType& element)
+		{
+			Handle node = BackNode();
+			if (Allocator::Parser::IsNull(node))
+				return cEnd(); // LOG: OUT OF MEMORY
+
+			return _Insert(node, Allocator::Parse(node)->Count(), element);
+		}
+
+		// Adds element to the end of the list
+		// Move temp
+		//
+		// @param: element - reference to element to add
+		// @return: Iterator to inserted location
+		const_iterator Add(ElementType&& element)
+		{
+			Handle node = BackNode();
+			if (Allocator::Parser::IsNull(node))
+				return cEnd(); // LOG: OUT OF MEMORY
+
+			return _Insert(node, Allocator::Parse(node)->Count(), _EVEREST Move(element));
+		}
+
+		// Inserts new element after given element
+		// if after is end of list, add to end of list
+		//
+		// @param: element - reference to element to add
+		// @param: after - Iterator to insert after
+		// @return: Iterator to inserted location
+		_INLINE const_iterator Insert(const ElementType& element, const_iterator after)
+		{
+			if (after.GetNode() == _tail)
+				return Add(element);
+
+			return _Insert(after.GetNode(), after.GetIndex() + 1, element);
+		}
+
+		// Inserts new element after given element
+		// if after is end of list, add to end of list
+		// Move Temp version.
+		//
+		// @param: element - reference to element to add
+		// @param: after - Iterator to insert after
+		// @return: Iterator to inserted location
+		_INLINE const_iterator Insert(ElementType&& element, const_iterator after)
+		{
+			if (after.GetNode() == _tail)
+				return Add(_EVEREST Move(element));
+
+			return _Insert(after.GetNode(), after.GetIndex() + 1, _EVEREST Move(element));
+		}
+
+		// Remove the first equal element from the list
+		//
+		// @param: element - element to the remove
+		void Remove(const ElementType& element)
+		{
+			Result found = Find(element);
+			if (found._first)
+				Remove(found._second);
+		}
+
+		// Remove an element from the list using iterator
+		// This is method is faster that Remove(ElementType)
+		//
+		// @param: it - iterator to the element
+		void Remove(iterator it)
+		{
+			Handle node = it.GetNode();
+			if (node == _head || node == _tail)
+				return;
+
+			Node* current = Allocator::Parse(node);
+			current->Erase(it.GetIndex());
+			_size--;
+
+			if (current->Count() == 0)
+			{
+				ReleaseNode(node);
+				return;
+			}
+
+			// Keep nodes at least half full, take elements from next node or merge with it
+			Handle next = current->GetNext();
+			if (current->Count() >= K / 2 || next == _tail)
+				return;
+
+			Node* nextNode = Allocator::Parse(next);
+			uint32 count = current->Count() + nextNode->Count() <= K ? nextNode->Count() : K / 2 - current->Count();
+
+			Memcopy(current->Elements() + current->Count(), nextNode->Elements(), count * sizeof(ElementType));
+			current->SetCount(current->Count() + count);
+
+			if (count == nextNode->Count())
+			{
+				nextNode->SetCount(0);
+				ReleaseNode(next);
+			}
+			else
+			{
+				Memmove(nextNode->Elements(), nextNode->Elements() + count, (nextNode->Count() - count) * sizeof(ElementType));
+				nextNode->SetCount(nextNode->Count() - count);
+			}
+		}
+
+		// Remove all elements and nodes
+		void Clear()
+		{
+			Handle node = Allocator::Parse(_head)->GetNext();
+			while (node != _tail)
+			{
+				Handle next = Allocator::Parse(node)->GetNext();
+				ReleaseNode(node);
+				node = next;
+			}
+
+			_size = 0;
+		}
+
+		// Finds an element start from the begin of the list
+		//
+		// @param: element - element to find
+		// @return: Pair of found flag and iterator to found item
+		Result Find(const ElementType& element) const
+		{
+			Handle node = Allocator::Parse(_head)->GetNext();
+			while (node != _tail)
+			{
+				const Node* current = Allocator::Parse(node);
+				SSIZE_T index = FindIndex(current->Elements(), current->Count(), element);
+				if (index != INDEX_NONE)
+					return Result(true, const_iterator(node, (uint32)index));
+
+				node = current->GetNext();
+			}
+
+			return Result(false, cEnd());
+		}
+
+		// Finds an element start from the end of the list
+		//
+		// @param: element - element to find
+		// @return: Pair of found flag and iterator to found item
+		Result FindLast(const ElementType& element) const
+		{
+			Handle node = Allocator::Parse(_tail)->GetPrev();
+			while (node != _head)
+			{
+				const Node* current = Allocator::Parse(node);
+				SSIZE_T index = FindLastIndex(current->Elements(), current->Count(), element);
+				if (index != INDEX_NONE)
+					return Result(true, const_iterator(node, (uint32)index));
+
+				node = current->GetPrev();
+			}
+
+			return Result(false, cEnd());
+		}
+
+		// Return true if the list is empty
+		_INLINE bool Empty() const
+		{
+			return _size == 0;
+		}
+
+		// Check if this list containes an element
+		//
+		// @param: element - The element to search
+		// @return: true if found
+		_INLINE bool Contains(const ElementType& element) const
+		{
+			return Find(element)._first;
+		}
+
+		// Copy all elements in container, in list order
+		template <typename Container>
+		void ToArray(_out_ref_ Container& array) const
+		{
+			Handle node = Allocator::Parse(_head)->GetNext();
+			while (node != _tail)
+			{
+				const Node* current = Allocator::Parse(node);
+				for (uint32 index = 0; index < current->Count(); index++)
+					array.Add(current->GetElement(index));
+
+				node = current->GetNext();
+			}
+		}
+
+		// Return the list size
+		_INLINE uint32 Size() const
+		{
+			return _size;
+		}
+
+		// Return count of nodes holding elements
+		_INLINE uint32 NodeCount() const
+		{
+			return _nodes;
+		}
+
+		// Returns reference to the last element of the list
+		// Stack method
+		//
+		// @return: reference element
+		ElementType& Top()
+		{
+			Node* last = Allocator::Parse(Allocator::Parse(_tail)->GetPrev());
+			return last->GetElement(last->Count() - 1);
+		}
+
+		// Returns const reference to the last element of the list
+		// Stack method
+		//
+		// @return: const reference element
+		const ElementType& Top() const
+		{
+			const Node* last = Allocator::Parse(Allocator::Parse(_tail)->GetPrev());
+			return last->GetElement(last->Count() - 1);
+		}
+
+		// Add element to the stack
+		// Stack method
+		//
+		// @param: element - const reference to element to add
+		// @return: Iterator to inserted location
+		const_iterator Push(const ElementType& element)
+		{
+			return Add(element);
+		}
+
+		// Add element to the stack, by move temp
+		// Stack method
+		//
+		// @param: element - rvalue to element to add
+		// @return: Iterator to inserted location
+		const_iterator Push(ElementType&& element)
+		{
+			return Add(_EVEREST Move(element));
+		}
+
+		// Remove the last in element of the stack
+		// Stack method
+		void Pop()
+		{
+			if (_size)
+				Remove(--End());
+		}
+
+		// Returns reference to the front element from List
+		// Queue method
+		//
+		// @return: reference element
+		_INLINE ElementType& Front()
+		{
+			return Allocator::Parse(Allocator::Parse(_head)->GetNext())->GetElement(0);
+		}
+
+		// Returns const reference to the front element from List
+		// Queue method
+		//
+		// @return: const reference element
+		_INLINE const ElementType& Front() const
+		{
+			return Allocator::Parse(Allocator::Parse(_head)->GetNext())->GetElement(0);
+		}
+
+		// Insert an element at the end of the list
+		// Queue method
+		//
+		// @param: element - reference to element to insert
+		// @return: Iterator to inserted location
+		const_iterator Enqueue(const ElementType& element)
+		{
+			return Add(element);
+		}
+
+		// Insert an element at the end of the list, Move temp
+		// Queue method
+		//
+		// @param: element - reference to element to insert
+		// @return: Iterator to inserted location
+		const_iterator Enqueue(ElementType&& element)
+		{
+			return Add(_EVEREST Move(element));
+		}
+
+		// Remove an element from the front of the list
+		// Queue method
+		void Dequeue()
+		{
+			if (_size)
+				Remove(Begin());
+		}
+
+		// Reserve nodes for count elements in the allocator, so the next added nodes
+		// are allocated contiguously, in the same order they are added.
+		//
+		// @param: count(1) - the count of elements to reserve nodes for
+		_INLINE void Reserve(uint32 count = 1)
+		{
+			allocator.Reserve((count + K - 1) / K);
+		}
+
+		// Appends all elements of other container at the end of the list, in order,
+		// nodes are reserved first so they are laid out in memory in traversal order.
+		// container should support iterators & Size()
+		//
+		// @param: _container - the other container to append
+		template < class Container >
+		void Append(const Container& _container)
+		{
+			Reserve(_container.Size());
+
+			// Iterate throw container, should support iteration.
+			auto it = _container.CreateConstIterator();
+			for (; it != _container.cEnd(); ++it)
+				Add(*it);
+		}
+
+		// Return an iterator start from the begining of the list
+		_INLINE iterator CreateIterator()
+		{
+			return Begin();
+		}
+
+		// Return a const iterator start from the begining of the list
+		_INLINE const_iterator CreateConstIterator() const
+		{
+			return cBegin();
+		}
+
+		// Returns an iterator to the begin of the list
+		// This is the first element of the node after head
+		iterator Begin()
+		{
+			return iterator(Allocator::Parse(_head)->GetNext(), 0);
+		}
+
+		// Returns a const iterator to the begin of the list
+		// This is the first element of the node after head
+		const_iterator cBegin() const
+		{
+			return const_iterator(Allocator::Parse(_head)->GetNext(), 0);
+		}
+
+		// Returns an iterator to the end of the list
+		// This is the tail node
+		iterator End()
+		{
+			return iterator(_tail, 0);
+		}
+
+		// Returns a const iterator to the end of the list
+		// This is the tail node
+		const_iterator cEnd() const
+		{
+			return const_iterator(_tail, 0);
+		}
+
+	protected:
+
+		// Construct an element before index of node, a full node is split in half first
+		//
+		// @param: node - The node to insert in
+		// @param: index - Index in the node, up to node count
+		// @param: args - element constructor arguments
+		// @return: Iterator to inserted location
+		template < class... Args >
+		const_iterator _Insert(Handle node, uint32 index, Args&&... args)
+		{
+			if (Allocator::Parser::IsNull(node))
+				return cEnd(); // LOG: OUT OF MEMORY
+
+			if (Allocator::Parse(node)->Count() == K)
+			{
+				// Upper half moves to a new node after node
+				Handle next = NewNode(node);
+				if (Allocator::Parser::IsNull(next))
+					return cEnd(); // LOG: OUT OF MEMORY
+
+				Node* current = Allocator::Parse(node);
+				Node* split = Allocator::Parse(next);
+
+				Memcopy(split->Elements(), current->Elements() + K / 2, (K - K / 2) * sizeof(ElementType));
+				split->SetCount(K - K / 2);
+				current->SetCount(K / 2);
+
+				if (index > K / 2)
+				{
+					node = next;
+					index -= K / 2;
+				}
+			}
+
+			Node* current = Allocator::Parse(node);
+			current->OpenGap(index);
+			new (current->Elements() + index) ElementType(_EVEREST Forward<Args>(args)...);
+
+			// Update size
+			_size++;
+
+			return const_iterator(node, index);
+		}
+
+		// Return the first node if it has space, or a new node at the front
+		_INLINE Handle FrontNode()
+		{
+			Handle node = Allocator::Parse(_head)->GetNext();
+			if (node == _tail || Allocator::Parse(node)->Count() == K)
+				node = NewNode(_head);
+
+			return node;
+		}
+
+		// Return the last node if it has space, or a new node at the end
+		_INLINE Handle BackNode()
+		{
+			Handle node = Allocator::Parse(_tail)->GetPrev();
+			if (node == _head || Allocator::Parse(node)->Count() == K)
+				node = NewNode(node);
+
+			return node;
+		}
+
+		// Allocate an empty node and link it after a node
+		//
+		// @param: afterNode - The node to link after
+		// @return: the new node, or null handle if out of memory
+		Handle NewNode(Handle afterNode)
+		{
+			Handle node = allocator.Allocate();
+			if (Allocator::Parser::IsNull(node))
+				return node; // LOG: OUT OF MEMORY
+
+			Handle next = Allocator::Parse(afterNode)->GetNext();
+
+			// Link node
+			Allocator::Parse(node)->Init(afterNode, next);
+			Allocator::Parse(next)->SetPrev(node);
+			Allocator::Parse(afterNode)->SetNext(node);
+
+			_nodes++;
+			return node;
+		}
+
+		// Initialize list head & tail
+		_INLINE void Init()
+		{
+			// Init allocator instance
+			allocator.Init();
+
+			_head = allocator.Allocate();
+			_tail = allocator.Allocate();
+
+			Allocator::Parse(_head)->Init(_head, _tail);
+			Allocator::Parse(_tail)->Init(_head, _tail);
+		}
+
+		// Unlink a node, destroy its elements and deallocate it
+		_INLINE void ReleaseNode(const Handle& node)
+		{
+			Node* current = Allocator::Parse(node);
+			Allocator::Parse(current->GetPrev())->SetNext(current->GetNext());
+			Allocator::Parse(current->GetNext())->SetPrev(current->GetPrev());
+
+			_EVEREST Destroy(current->Elements(), current->Count());
+			allocator.Deallocate(node);
+
+			_nodes--;
+		}
+
+	private:
+
+		// The list head node, empty node
+		Handle _head;
+
+		// The list tail node, empty node
+		Handle _tail;
+
+		// Count of elements in the list
+		uint32 _size;
+
+		// Count of nodes holding elements, not including head & tail
+		uint32 _nodes;
+
+		// Allocator instance
+		Allocator allocator;
+
+	};
+}
@@ -29,6 +29,7 @@ SOFTWARE.
 #include "../Template/Common.h"  
 
 #include <math.h>
+#include <atomic>
 #include <iostream> /* For basic print log */
 
 namespace Everest
@@ -230,11 +231,11 @@ namespace Everest
 			int32 current = freeHead;
 
 			// Check for free chunk of almost the same size
-			ChunkDesc& freeDesc = lookupTable[current];
 			while (current != INDEX_NONE)
 			{
-				if (packets >= freeDesc.PacketCount // Take the whole chunk without split
-					|| (packets - freeDesc.PacketCount) < MIN_PACKETS)
+				ChunkDesc& freeDesc = lookupTable[current];
+				if (packets <= freeDesc.PacketCount // Take the whole chunk without split
+					&& (freeDesc.PacketCount - packets) < MIN_PACKETS)
 				{
 					// Unlink free chunk
 					UnlinkFree(&freeDesc);
@@ -250,7 +251,7 @@ namespace Everest
 				{
 					// Retrive an index to store the splitted free chunk
 					int32 validIndex = RecycledPointersCount ? 
-						recycledPointers[RecycledPointersCount--] : ++CurrentChunkIndex;
+						recycledPointers[--RecycledPointersCount] : ++CurrentChunkIndex;
 
 					// Create the new allocation chunk
 					ChunkDesc& newChunk		= lookupTable[validIndex];
@@ -353,6 +354,56 @@ namespace Everest
 			Dealloc((UINTPTR)&lookupTable[IndexOf(ptr)]);
 		}
 
+		// Grow a handle allocation in place by taking packets from the next chunk if free,
+		// the handle & its memory do not move, so handles & offsets into it stay valid
+		//
+		// @param: handle - The handle to grow
+		// @param: newSize - New size in bytes
+		// @param: alignment(ALIGNMENT_OPTIMAL) - The alignment the handle was allocated with
+		// @return: true if the allocation holds newSize bytes
+		bool Expand(UINTPTR handle, SIZE_T newSize, uint32 alignment = ALIGNMENT_OPTIMAL)
+		{
+			ChunkDesc* chunk = (ChunkDesc*)handle;
+			if (!chunk)
+				return false;
+
+			// Find how many packets we need
+			SIZE_T packets = GetPacketCount(newSize + alignment + sizeof(uint32));
+			if (packets <= chunk->PacketCount)
+				return true;
+
+			ChunkDesc* next = (chunk->NextIndex == INDEX_NONE ? nullptr : &lookupTable[chunk->NextIndex]);
+			if (!next || CheckBit(next->Flags, FLAG_CHUNK_STATUS)) // Next chunk is not FREE
+				return false;
+
+			uint32 needPackets = packets - chunk->PacketCount;
+			if ((needPackets == next->PacketCount)
+				|| (needPackets < next->PacketCount && (next->PacketCount - needPackets) < MIN_PACKETS)) // Found free chunk that is equal to needed packets
+			{
+				// Unlink next chunk
+				RecycleIndex(chunk->NextIndex);
+				Unlink(next);
+				UnlinkFree(next);
+
+				// Update chunk, it takes all next chunk packets
+				chunk->PacketCount += next->PacketCount;
+				return true;
+			}
+			else if (needPackets < next->PacketCount) // Found enought packets in the next chunk
+			{
+				// Update next chunk by shrinking it
+				next->MappedPtr = Offset(next->MappedPtr, needPackets * PACKET_SIZE);
+				next->PacketCount -= needPackets;
+				MemWrite(chunk->NextIndex, next->MappedPtr, -(int32)sizeof(int32));
+
+				// Update chunk by expanding it
+				chunk->PacketCount += needPackets;
+				return true;
+			}
+
+			return false;
+		}
+
 		// Reallocate a handle previously allocated by Alloc
 		//
 		// @param: oldHandle - The old handle to reallocate
@@ -380,46 +431,18 @@ namespace Everest
 			{
 				// New size > old size,
 				// Try to merge old chunk with next chunk (if free)
-				ChunkDesc* next = (oldChunk->NextIndex == INDEX_NONE ? nullptr : &lookupTable[oldChunk->NextIndex]);
-				if (next && !CheckBit(next->Flags, FLAG_CHUNK_STATUS)) // Next chunk is FREE
-				{
-					uint32 needPackets = packets - oldChunk->PacketCount;
-					
-					if ((needPackets == next->PacketCount) 
-						|| ((next->PacketCount - needPackets) < MIN_PACKETS)) // Found free chunk that is equal to needed packets
-					{
-						// Unlink next chunk
-						RecycleIndex(oldChunk->NextIndex);
-						Unlink(next);
-						UnlinkFree(next);
-
-						// Update old chunk
-						oldChunk->PacketCount += needPackets;
-
-						// Return old chunk handle
-						return oldHandle;
-					}
-					else if (needPackets < next->PacketCount) // Found enought packets in the next chunk
-					{
-						// Update next chunk by shrinking it
-						next->MappedPtr = Offset(next->MappedPtr, needPackets * PACKET_SIZE);
-						next->PacketCount -= needPackets;
-						MemWrite(oldChunk->NextIndex, next->MappedPtr, -(int32)sizeof(int32));
-
-						// Update old chunk by expanding it
-						oldChunk->PacketCount += needPackets;
-
-						// Return old chunk handle
-						return oldHandle;
-					}
-				}
+				if (Expand(oldHandle, newSize, alignment))
+					return oldHandle;
 			}
 			
 			// Allocate new chunk with new size
 			UINTPTR newChunk = Alloc(newSize, alignment);
+			if (!newChunk)
+				return (UINTPTR)nullptr; // LOG: OUT OF MEMORY
 
-			// Copy old contents to it
-			memcpy(((ChunkDesc*)newChunk)->MappedPtr, oldChunk->MappedPtr, newSize);
+			// Copy old contents to it, no more than the old chunk holds
+			SIZE_T oldSize = oldChunk->PacketCount * PACKET_SIZE - alignment - sizeof(uint32);
+			Memcopy(((ChunkDesc*)newChunk)->MappedPtr, oldChunk->MappedPtr, newSize < oldSize ? newSize : oldSize);
 
 			// free old chunk
 			Dealloc(oldHandle);
@@ -430,6 +453,9 @@ namespace Everest
 		void Defragment()
 		{
 			//TODO:...
+
+			// Allocations moved, cached pointers should resolve their handles again
+			Epoch().fetch_add(1, std::memory_order_release);
 		}
 
 		// New function that allocate and construct empty an object
@@ -437,7 +463,7 @@ namespace Everest
 		//
 		// @return: Pointer to the allocated type
 		template<class Type>
-		UINTPTR _NEW()
+		UINTPTR New()
 		{
 			UINTPTR handle = Alloc(sizeof(Type), alignof(Type)); // TODO: FOR NOW!
 			new(((ChunkDesc*)handle)->MappedPtr) Type();
@@ -451,14 +477,14 @@ namespace Everest
 		// @param: args - The constructing data
 		// @return: Pointer to the allocated type
 		template<class Type, class ...Args>
-		UINTPTR _NEW(Args && ...args)
+		UINTPTR New(Args && ...args)
 		{
 			UINTPTR handle = Alloc(sizeof(Type), alignof(Type));
 			new(((ChunkDesc*)handle)->MappedPtr) Type(_EVEREST Forward<Args>(args)...);
 			return handle;
 		}
 
-		void _DELETE(UINTPTR& handle)
+		void Delete(UINTPTR& handle)
 		{
 			Dealloc(handle);
 		}
@@ -472,10 +498,22 @@ namespace Everest
 			return (reinterpret_cast<ChunkDesc*>(handle))->MappedPtr;
 		}
 
-		
+		// Return the defragmentation epoch, it changes every time a dynamic segment moves allocations,
+		// pointers returned by PointerOf stay valid while the epoch is the same
+		static uint32 GetEpoch()
+		{
+			return Epoch().load(std::memory_order_acquire);
+		}
 
 	private:
 
+		// Defragmentation epoch shared by all dynamic segments, as handles are parsed with no segment
+		static std::atomic<uint32>& Epoch()
+		{
+			static std::atomic<uint32> epoch(0);
+			return epoch;
+		}
+
 		void Unlink(ChunkDesc* chunk)
 		{
 			if (chunk->NextIndex != INDEX_NONE)
@@ -490,6 +528,11 @@ namespace Everest
 				lookupTable[chunk->NextFreeIndex].PrevFreeIndex = chunk->PrevFreeIndex;
 			if (chunk->PrevFreeIndex != INDEX_NONE)
 				lookupTable[chunk->PrevFreeIndex].NextFreeIndex = chunk->NextFreeIndex;
+			else if (freeHead == int32(chunk - lookupTable)) // Chunk is the free list head
+				freeHead = chunk->NextFreeIndex;
+
+			chunk->PrevFreeIndex = INDEX_NONE;
+			chunk->NextFreeIndex = INDEX_NONE;
 		}
 
 		void RecycleIndex(int32 index)
@@ -500,7 +543,9 @@ namespace Everest
 		void SetFree(ChunkDesc* chunk)
 		{
 			int32 newIndex = ((UINTPTR)chunk - (UINTPTR)lookupTable) / CHUNK_DESC_SIZE;
-			lookupTable[freeHead].PrevFreeIndex = newIndex;
+			if (freeHead != INDEX_NONE)
+				lookupTable[freeHead].PrevFreeIndex = newIndex;
+			chunk->PrevFreeIndex = INDEX_NONE;
 			chunk->NextFreeIndex = freeHead;
 			chunk->Flags = ClearBit(chunk->Flags, FLAG_CHUNK_STATUS);
 			freeHead = newIndex;
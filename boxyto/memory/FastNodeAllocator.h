@@ -41,8 +41,8 @@ namespace Everest
 	public:
 
 		// typedefs
-		typedef typename UINTPTR Handle;
-		typedef typename T ElementType;
+		typedef UINTPTR Handle;
+		typedef T ElementType;
 
 		// Options
 		enum { OPTION_RESIZABLE = false };
@@ -89,6 +89,13 @@ namespace Everest
 			return segmentManager;
 		}
 
+		// Check if handles allocated by other can be deallocated by this allocator,
+		// nodes are never deallocated, allocators of the same segment share them
+		_INLINE bool Shares(const FastNodeAllocator& other) const
+		{
+			return segmentManager == other.segmentManager;
+		}
+
 		// Allocate a new node
 		//
 		// @return: Allocator handle to node
@@ -102,6 +109,12 @@ namespace Everest
 			/* Nothing to do here */
 		}
 
+		// Reserve count of nodes for the next Allocate calls
+		void Reserve(uint32)
+		{
+			/* Nodes are already allocated in order from the static segment */
+		}
+
 		// Parse a handle and return it's pointer
 		// The handle must be previously allocated using this allocator type
 		//
@@ -118,7 +131,7 @@ namespace Everest
 		struct Parser
 		{
 
-			typedef typename Handle Handle;
+			typedef UINTPTR Handle;
 
 			// Parse a handle and return it's pointer
 			// The handle must be previously allocated using this allocator type
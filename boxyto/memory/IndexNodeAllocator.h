@@ -0,0 +1,357 @@
+/*****************************************************************************
+The MIT License(MIT)
+
+Copyright(c) 2016 Amr Esam
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*********************************************************************************/
+#pragma once
+
+#include "DynamicSegment.h"
+#include "../system.h"
+#include "../Template/Common.h"
+#include "MemoryOps.h"
+#include "Pointer.h"
+
+/* For std::shared_ptr */
+#include <memory>
+
+namespace Everest
+{
+	// Default tag for index pools,
+	// all IndexNodeAllocators of the same node type without a tag share this pool
+	struct DefaultIndexPool {};
+
+	// Slots pool shared by all IndexNodeAllocators of the same node type & tag.
+	// Because the pool is known at compile time from the node type & tag,
+	// a node handle is just a 32-bit slot index into the pool allocation.
+	// Slot 0 is never allocated, it is the null handle.
+	//
+	// The pool is created by the first allocator Init, every initialized allocator holds
+	// a reference to it, and it is released to its segment with the last reference.
+	// The pool is not thread safe, containers sharing a pool must be used by one thread at a time,
+	// give containers used by other threads their own Tag.
+	template <class T, class Tag>
+	struct IndexNodePool
+	{
+		// Create a pool of capacity slots, plus the null slot
+		//
+		// @param: segment - Segment manager to allocate the pool from
+		// @param: slots - Count of slots, not including the null slot
+		IndexNodePool(std::shared_ptr<DynamicSegment> segment, uint32 slots) :
+			segmentManager(segment),
+			capacity(slots + 1),
+			nextFree(1),
+			recycledHead(0)
+		{
+			// LOG: OUT OF MEMORY, the pool is allocated again by the first Allocate
+			data = segmentManager->Alloc(sizeof(T) * (SIZE_T)capacity, alignof(T));
+			if (!data)
+				capacity = 1;
+
+			current = this;
+		}
+
+		// Release the pool allocation, all handles allocated from this pool are no longer valid
+		~IndexNodePool()
+		{
+			if (data)
+				segmentManager->Dealloc(data);
+
+			if (current == this)
+				current = nullptr;
+		}
+
+		// Segment manager that owns the pool allocation
+		std::shared_ptr<DynamicSegment> segmentManager;
+
+		// The allocated handle for all slots
+		UINTPTR data;
+
+		// Count of slots in the allocation, including the null slot
+		uint32 capacity;
+
+		// Next never used slot at the end of the allocation
+		// We use this ONLY if no recycled slots
+		uint32 nextFree;
+
+		// Recycled linked-list head, 0 if nothing recycled
+		uint32 recycledHead;
+
+		// The live pool for T & Tag, owned by the allocators using it
+		static std::weak_ptr<IndexNodePool> instance;
+
+		// The live pool for T & Tag, to parse handles without locking instance
+		static IndexNodePool* current;
+	};
+
+	template <class T, class Tag>
+	std::weak_ptr<IndexNodePool<T, Tag>> IndexNodePool<T, Tag>::instance;
+
+	template <class T, class Tag>
+	IndexNodePool<T, Tag>* IndexNodePool<T, Tag>::current = nullptr;
+
+	template <class T, class Tag = DefaultIndexPool>
+	class IndexNodeAllocator
+	{
+	public:
+
+		// typedefs
+		typedef uint32 Handle;
+		typedef T ElementType;
+		typedef IndexNodePool<T, Tag> Pool;
+
+		// Options
+		enum { OPTION_RESIZABLE = true };
+		enum { OPTION_POOL = true };
+		enum { OPTION_RECYCLE = true };
+
+		// Allocator element size
+		enum { ELEMENT_SIZE = sizeof(T) };
+
+		// Rebind other instance
+		template<class T2>
+		struct Rebind
+		{
+			typedef IndexNodeAllocator<T2, Tag> Other;
+		};
+
+		// Create from segment manager
+		//
+		// @param: segment - Segment manager to allocate the pool from
+		// @param: capacity - Initial slots count, the pool grows by it on Init
+		IndexNodeAllocator(std::shared_ptr<DynamicSegment> segment, uint32 capacity) :
+			segmentManager(segment),
+			capacity(capacity),
+			reservedCount(0)
+		{}
+
+		// Create from other same allocator
+		IndexNodeAllocator(const IndexNodeAllocator& other) :
+			segmentManager(other.GetSegmentManager()),
+			capacity(other.GetCapacity()),
+			reservedCount(0)
+		{}
+
+		// Create from other allocator with other type
+		template<class T2>
+		IndexNodeAllocator(const IndexNodeAllocator<T2, Tag>& other) :
+			segmentManager(other.GetSegmentManager()),
+			capacity(other.GetCapacity()),
+			reservedCount(0)
+		{}
+
+		// Destructor
+		~IndexNodeAllocator()
+		{
+			/* Nothing to do here, the pool is released with its last allocator */
+		}
+
+		// Delete = operator
+		template<class T2>
+		IndexNodeAllocator& operator= (const IndexNodeAllocator<T2, Tag>& other) = delete;
+
+		// Join the shared pool, creating it if no allocator uses it,
+		// the pool grows so it has room for capacity more slots
+		// This should called before using the allocator
+		void Init()
+		{
+			// LOG CHECK(ELEMENT_SIZE >= sizeof(Handle)
+			//...
+
+			if (pool)
+				return;
+
+			pool = Pool::instance.lock();
+			if (!pool)
+			{
+				pool = std::make_shared<Pool>(segmentManager, capacity);
+				Pool::instance = pool;
+				return;
+			}
+
+			// LOG: The pool is allocated from another segment, this allocator shares it
+			if (pool->segmentManager != segmentManager)
+				segmentManager = pool->segmentManager;
+
+			if (pool->capacity - pool->nextFree < capacity)
+				Expand(pool->nextFree, capacity);
+		}
+
+		// Get Segment manager used by this allocator
+		std::shared_ptr<DynamicSegment> GetSegmentManager() const
+		{
+			return segmentManager;
+		}
+
+		// Check if handles allocated by other can be deallocated by this allocator,
+		// initialized allocators of the same Tag share one pool
+		_INLINE bool Shares(const IndexNodeAllocator& other) const
+		{
+			return pool && pool == other.pool;
+		}
+
+		// Return allocator capacity
+		_INLINE uint32 GetCapacity() const
+		{
+			return capacity;
+		}
+
+		// Allocate a new slot by recycling or adding new
+		//
+		// @return - Handle to the allocated slot, null handle if out of memory
+		Handle Allocate()
+		{
+			if (pool->recycledHead && !reservedCount) // Read slot from recycle...
+			{
+				Handle result = pool->recycledHead;
+				pool->recycledHead = *reinterpret_cast<Handle*>(Parse(result));
+				return result;
+			}
+			else // Allocate new slot...
+			{
+				// Expand the pool if full, handles are indices so they survive the reallocation
+				if (pool->nextFree == pool->capacity && !Expand(pool->nextFree, pool->capacity + 1))
+					return null_handle(); // LOG: OUT OF MEMORY
+
+				if (reservedCount)
+					--reservedCount;
+
+				return pool->nextFree++;
+			}
+		}
+
+		// Reserve count of contiguous slots at the end of the pool,
+		// the next count calls to Allocate return them in order, skipping recycled slots
+		//
+		// @param: count - Count of slots to reserve
+		void Reserve(uint32 count)
+		{
+			if (pool->capacity - pool->nextFree < count && !Expand(pool->nextFree, count))
+				return; // LOG: OUT OF MEMORY
+
+			reservedCount = count;
+		}
+
+		// Allocate and construct, a new node
+		//
+		// @param: args... - The constructor arguments
+		// @return: Allocator handle to object, null handle if out of memory
+		template<class ...Args>
+		Handle Allocate(Args && ...args)
+		{
+			Handle handle = Allocate();
+			if (handle == null_handle())
+				return handle;
+
+			new(Parse(handle)) T(_EVEREST Forward<Args>(args)...);
+			return handle;
+		}
+
+		// Deallocate a slot by recycling it
+		//
+		//@param: handle - Handle to the slot to deallocate & recycle
+		void Deallocate(Handle handle)
+		{
+			if (!handle)
+				return;
+
+			*reinterpret_cast<Handle*>(Parse(handle)) = pool->recycledHead;
+			pool->recycledHead = handle;
+		}
+
+		// Parse a handle and return it's pointer
+		// The handle must be previously allocated using this allocator type
+		//
+		// @param: handle - The handle to parse
+		// @return: Parsed pointer of type T
+		static T* Parse(const Handle& handle)
+		{
+			return reinterpret_cast<T*>(DynamicSegment::PointerOf(Pool::current->data)) + handle;
+		}
+
+		// Null handle
+		static const Handle null_handle() { return 0; }
+
+		struct Parser
+		{
+			typedef uint32 Handle;
+
+			// Parse a handle and return it's pointer
+			// The handle must be previously allocated by IndexNodeAllocator<Type, Tag>
+			//
+			// @param: handle - The handle to parse
+			// @return: Parsed pointer of type Type
+			template <class Type>
+			static Type* Parse(const Handle& handle)
+			{
+				return reinterpret_cast<Type*>(
+					DynamicSegment::PointerOf(IndexNodePool<Type, Tag>::current->data)) + handle;
+			}
+
+			static bool IsNull(Handle handle)
+			{
+				return handle == null_handle();
+			}
+		};
+
+	private:
+
+		// Expand the pool allocation so it has room for count slots after used slots,
+		// the pool at least doubles so expanding is amortized
+		//
+		// @param: used - Count of used slots, including the null slot
+		// @param: count - Count of slots required after the used slots
+		// @return: false if out of memory or the slots do not fit in 32-bit handles
+		bool Expand(uint32 used, uint32 count)
+		{
+			SIZE_T required = (SIZE_T)used + count;
+			SIZE_T doubled = (SIZE_T)pool->capacity * 2;
+			SIZE_T newCapacity = doubled > required ? doubled : required;
+			if (newCapacity > 0xFFFFFFFF)
+				newCapacity = 0xFFFFFFFF;
+			if (newCapacity < required)
+				return false; // LOG: Handles are 32-bit slot indices
+
+			UINTPTR handle = pool->data ?
+				pool->segmentManager->Realloc(pool->data, ELEMENT_SIZE * newCapacity, alignof(T)) :
+				pool->segmentManager->Alloc(ELEMENT_SIZE * newCapacity, alignof(T));
+			if (!handle)
+				return false; // LOG: OUT OF MEMORY, the pool keeps its slots
+
+			pool->data = handle;
+			pool->capacity = (uint32)newCapacity;
+			return true;
+		}
+
+		// The shared pool, null until Init
+		std::shared_ptr<Pool> pool;
+
+		// Segment manager instance
+		std::shared_ptr<DynamicSegment> segmentManager;
+
+		// Initial pool capacity
+		uint32 capacity;
+
+		// Count of reserved slots that are not allocated yet
+		uint32 reservedCount;
+
+	};
+}
@@ -0,0 +1,259 @@
+/*****************************************************************************
+The MIT License(MIT)
+
+Copyright(c) 2016 Amr Esam
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*********************************************************************************/
+#pragma once
+
+#include "DynamicSegment.h"
+#include "../system.h"
+#include "../Template/Common.h"
+#include "MemoryOps.h"
+#include "LinearAllocator.h"
+
+/* For std::shared_ptr */
+#include <memory>
+
+namespace Everest
+{
+	// Allocator for linear containers that stores up to N elements inline, inside the allocator itself,
+	// and only allocates from its spill allocator (LinearAllocator by default) past N elements.
+	// Small containers cost no segment allocation, and no handle indirection.
+	//
+	// Elements are relocated by memory copy when spilling, just like LinearAllocator reallocation
+	template < class T, uint32 N, class SpillAllocator = LinearAllocator<T> >
+	class InlineAllocator
+	{
+	public:
+
+		// Raw pointer to the elements, inline or spilled
+		struct pointer
+		{
+			T* ptr;
+
+			_INLINE T* Get() const
+			{
+				return ptr;
+			}
+
+			_INLINE T* operator+(uint32 index) const
+			{
+				return ptr + index;
+			}
+
+			_INLINE explicit operator bool() const
+			{
+				return ptr != nullptr;
+			}
+		};
+
+		// Options
+		enum { OPTION_RESIZABLE = true };
+		enum { OPTION_POOL = false };
+		enum { OPTION_RECYCLE = false };
+
+		// Allocator element size
+		enum { ELEMENT_SIZE = sizeof(T) };
+
+		// Count of inline elements
+		enum { INLINE_CAPACITY = N };
+
+		// Rebind other instance
+		template<class T2>
+		struct Rebind
+		{
+			typedef InlineAllocator<T2, N, typename SpillAllocator::template Rebind<T2>::Other> Other;
+		};
+
+		// Delete default constructor
+		InlineAllocator() = delete;
+
+		// Copy only the segment manager, elements are copied by the container
+		InlineAllocator(const InlineAllocator& other) :
+			size(0),
+			spilled(false),
+			spill(other.spill)
+		{}
+
+		// Create from segment manager
+		//
+		// @param: segment - The segment to spill to
+		// @param: spillCapacity(N * 2) - Capacity of the first spill allocation
+		InlineAllocator(std::shared_ptr<DynamicSegment> segment, uint32 spillCapacity = N * 2) :
+			size(0),
+			spilled(false),
+			spill(segment, spillCapacity > N ? spillCapacity : N + 1)
+		{}
+
+		// Destructor
+		~InlineAllocator()
+		{}
+
+		// Initialize this allocator, inline elements need no allocation
+		void Init()
+		{}
+
+		// Get Segment manager used by this allocator
+		std::shared_ptr<DynamicSegment> GetSegmentManager() const
+		{
+			return spill.GetSegmentManager();
+		}
+
+		// Allocate count, spilling all elements if required
+		//
+		// @param: count(1) - Count of elements to allocate
+		// @return: Pointer to the allocator data, null pointer if out of memory
+		pointer Allocate(uint32 count = 1)
+		{
+			if (spilled ? !spill.Allocate(count) : size + count > N && !Spill(size + count))
+				return pointer{ nullptr };
+
+			size += count;
+			return Get();
+		}
+
+		// Reserve capacity for count of elements, spilling all elements if required
+		//
+		// @param: count - Count of elements the allocator can hold without reallocation
+		// @return: false if out of memory
+		bool Reserve(uint32 count)
+		{
+			if (count <= GetCapacity())
+				return true;
+
+			if (!spilled && !Spill(size))
+				return false;
+
+			return spill.Reserve(count);
+		}
+
+		// Deallocate count of element from total capacity
+		//
+		// @param: count(1) - Count of element to deallocate
+		void Deallocate(uint32 count = 1)
+		{
+			size -= count;
+			if (spilled)
+				spill.Deallocate(count);
+		}
+
+		// Clear all allocated element
+		void Clear()
+		{
+			size = 0;
+			if (spilled)
+				spill.Clear();
+		}
+
+		// Fills elements of the container by an arbitary value
+		//
+		// @param: star - Index where to start the fill process, 0 if fill all elements
+		// @param: count - How many elements to fill
+		// @parma: value - the T value to fill in elements
+		_INLINE void Fill(int32 start, uint32 count, const T& value)
+		{
+			ConstructRange(Data() + start, value, count);
+		}
+
+		// Moves all elements start from index forward of the container by count,
+		// use this function with caution.
+		//
+		// @param: index - the index to start shifting from
+		// @param: count - count of elements to shift forward
+		// @param: size - array size
+		void ShiftForward(const uint32 index, const uint32 count, uint32 size)
+		{
+			uint32 shift = size - index - count;
+			Memmove(Data() + index + count, Data() + index, ELEMENT_SIZE * shift);
+		}
+
+		// Moves all elements start from index, to back by count
+		// use this function with caution.
+		//
+		// @param: index - the index to start shifting from
+		// @param: count - count of elements to shift back
+		void ShiftBackward(const uint32 index, const uint32 count, uint32 size)
+		{
+			uint32 shift = size - index - count;
+			Memmove(Data() + index, Data() + (index + count), ELEMENT_SIZE * shift);
+		}
+
+		// Get a pointer to the first element of the container
+		//
+		// @return: pointer - to the first element in the container
+		_INLINE pointer Get() const
+		{
+			pointer result = { Data() };
+			return result;
+		}
+
+		// Return allocator capacity
+		_INLINE uint32 GetCapacity() const
+		{
+			return spilled ? spill.GetCapacity() : N;
+		}
+
+		// Return true if elements are stored inline
+		_INLINE bool IsInline() const
+		{
+			return !spilled;
+		}
+
+	private:
+
+		// Return the first element
+		_INLINE T* Data() const
+		{
+			return spilled ? spill.Get().Get() : (T*)inlineData;
+		}
+
+		// Move inline elements to the spill allocator
+		//
+		// @param: count - Count of elements to allocate in the spill allocator
+		// @return: false if out of memory, elements stay inline
+		bool Spill(uint32 count)
+		{
+			spill.Init();
+			if (!spill.Allocate(count))
+				return false; // LOG: OUT OF MEMORY
+
+			Memcopy(spill.Get().Get(), inlineData, ELEMENT_SIZE * size);
+			spilled = true;
+			return true;
+		}
+
+	private:
+
+		// Inline elements
+		alignas(T) ubyte inlineData[N * sizeof(T)];
+
+		// Allocated elements count
+		uint32 size;
+
+		// True if elements moved to the spill allocator
+		bool spilled;
+
+		// Allocator used past N elements
+		SpillAllocator spill;
+
+	};
+}
@@ -35,13 +35,49 @@ SOFTWARE.
 
 namespace Everest
 {
-	template <class T>
+	// LinearAllocator growth policies,
+	// Grow returns the new capacity when required count of elements exceeds the capacity
+
+	// Grow capacity by half (1.5x), less memory waste with amortized O(1) growth
+	struct GrowthHalf
+	{
+		_INLINE static uint32 Grow(uint32 capacity, uint32 required)
+		{
+			uint32 result = capacity + capacity / 2;
+			return result > required ? result : required;
+		}
+	};
+
+	// Double capacity (2x), fewer reallocations
+	struct GrowthDouble
+	{
+		_INLINE static uint32 Grow(uint32 capacity, uint32 required)
+		{
+			uint32 result = capacity * 2;
+			return result > required && result > capacity ? result : required;
+		}
+	};
+
+	// Grow capacity by fixed chunks of elements, predictable memory usage
+	template < uint32 CHUNK = DEFAULT_CONTAINER_CAPACITY >
+	struct GrowthFixed
+	{
+		_INLINE static uint32 Grow(uint32 capacity, uint32 required)
+		{
+			return ((required + CHUNK - 1) / CHUNK) * CHUNK;
+		}
+	};
+
+	// Allocator for linear containers, all elements are in one dynamic segment allocation
+	//
+	// @param: GrowthPolicy - How capacity grows when exceeded, GrowthHalf (default), GrowthDouble or GrowthFixed<N>
+	template < class T, class GrowthPolicy = GrowthHalf >
 	class LinearAllocator
 	{
 	public:
 
 		// typedefs
-		typedef typename Pointer<T> pointer;
+		typedef Pointer<T> pointer;
 
 		// Options
 		enum { OPTION_RESIZABLE = true };
@@ -55,7 +91,7 @@ namespace Everest
 		template<class T2>
 		struct Rebind
 		{
-			typedef LinearAllocator<T2> Other;
+			typedef LinearAllocator<T2, GrowthPolicy> Other;
 		};
 
 		// Delete default constructor
@@ -97,15 +133,26 @@ namespace Everest
 		// Allocate count, reallocating all if required
 		//
 		// @param: count(1) - Count of elements to allocate
-		// @return: Pointer to the allocator data
+		// @return: Pointer to the allocator data, null pointer if out of memory
 		pointer Allocate(uint32 count = 1)
 		{
 			// Check for realloc requirements
-			CheckSize(count);
+			if (!CheckSize(count))
+				return pointer();
 
 			return data;
 		}
 
+		// Reserve capacity for count of elements, reallocating all if required
+		// This does not change count of allocated elements
+		//
+		// @param: count - Count of elements the allocator can hold without reallocation
+		// @return: false if out of memory
+		bool Reserve(uint32 count)
+		{
+			return count <= capacity || Grow(count);
+		}
+
 		// Deallocate count of element from total capacity
 		//
 		// @param: count(1) - Count of element to deallocate
@@ -120,6 +167,16 @@ namespace Everest
 			size = 0;
 		}
 
+		// Free the allocation back to the segment, Init allocates again
+		void Release()
+		{
+			if (data.GetHandle())
+				segmentManager->Dealloc(data.GetHandle());
+
+			data = pointer();
+			size = capacity = 0;
+		}
+
 		// Fills all elements of the container by an arbitary value
 		//
 		// @param: star - Index where to start the fill process, 0 if fill all elements
@@ -145,7 +202,8 @@ namespace Everest
 		void ShiftForward(const uint32 index, const uint32 count, uint32 size)
 		{
 			uint32 shift = size - index - count;
-			Memmove(Get() + index + count, Get() + index, ELEMENT_SIZE * shift);
+			T* elements = data.Get();
+			Memmove(elements + index + count, elements + index, ELEMENT_SIZE * shift);
 		}
 
 		//		C : count				I : Index
@@ -161,8 +219,9 @@ namespace Everest
 		// @param: count - count of elements to shift back
 		void ShiftBackward(const uint32 index, const uint32 count, uint32 size)
 		{
-			uint32 shift = size - index - 1;
-			Memmove(Get() + index, Get() + (index + count), ELEMENT_SIZE * shift);
+			uint32 shift = size - index - count;
+			T* elements = data.Get();
+			Memmove(elements + index, elements + (index + count), ELEMENT_SIZE * shift);
 		}
 
 		// Get a pointer to the first element of the container
@@ -181,12 +240,37 @@ namespace Everest
 
 	protected:
 
-		// Check & allocate (if required) for addtional size for count of elements
-		void CheckSize(uint32 count)
+		// Check & allocate (if required) for addtional size for count of elements,
+		// size changes only if the allocation succeeds
+		//
+		// @return: false if out of memory
+		bool CheckSize(uint32 count)
 		{
+			uint32 required = size + count;
+			if (required < size)
+				return false; // LOG: Count overflow
+
 			// Resize the allocator if required
-			if ((size += count) > capacity)
-				data = segmentManager->Realloc(data.GetHandle(), ELEMENT_SIZE * size, alignof(T));
+			if (required > capacity && !Grow(GrowthPolicy::Grow(capacity, required)))
+				return false;
+
+			size = required;
+			return true;
+		}
+
+		// Reallocate all elements to a new capacity
+		//
+		// @param: newCapacity - The new capacity in elements
+		// @return: false if out of memory, elements stay in the old allocation
+		bool Grow(uint32 newCapacity)
+		{
+			UINTPTR handle = segmentManager->Realloc(data.GetHandle(), (SIZE_T)ELEMENT_SIZE * newCapacity, alignof(T));
+			if (!handle)
+				return false; // LOG: OUT OF MEMORY
+
+			data = handle;
+			capacity = newCapacity;
+			return true;
 		}
 
 	private:
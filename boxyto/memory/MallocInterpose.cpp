@@ -0,0 +1,797 @@
+/*****************************************************************************
+The MIT License(MIT)
+
+Copyright(c) 2016 Amr Esam
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*********************************************************************************/
+
+// Linux malloc/free and global new/delete interposition on top of OSMemory
+//
+// Build the shared library with "make" in the boxyto directory, then run any binary with:
+//     BOXYTO_ARENA_SIZE=<bytes> LD_PRELOAD=/path/to/libboxytomalloc.so ./app
+//
+// The arena is reserved once with OSMemory::Init (huge pages when available),
+// BOXYTO_ARENA_SIZE is the arena size in bytes (default 1 GiB).
+// Set BOXYTO_MALLOC_STATS=1 to print segments usage at exit.
+//
+// Allocations are served as follows:
+//  1) Small requests, up to 1 MiB, use per-thread size-class heaps.
+//     Every class takes whole OSMemory segments (one huge page) shared by all threads,
+//     a thread heap takes slices of 64 KiB (or one block) of them and recycles its blocks,
+//     a block freed by another thread is recycled by that thread.
+//  2) Larger requests take their own OSMemory segment of one or more pages.
+//  3) If the arena can not be created or is exhausted, or the alignment is larger than
+//     the page size, requests go to the libc allocator. Free & realloc of these blocks
+//     go back to libc.
+
+#include "../system.h"
+
+#if defined(__linux__)
+
+#include "OSMemory.h"
+#include "MemoryOps.h"
+
+#include <atomic>
+#include <new>
+#include <dlfcn.h>
+#include <errno.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+// libc allocator, used when the arena is not available
+extern "C"
+{
+	void* __libc_malloc(size_t size);
+	void* __libc_calloc(size_t count, size_t size);
+	void* __libc_realloc(void* ptr, size_t size);
+	void* __libc_memalign(size_t alignment, size_t size);
+	void __libc_free(void* ptr);
+}
+
+using namespace Everest;
+
+namespace
+{
+	enum
+	{
+		CLASS_SMALL_MAX = 1024, // Small classes are multiples of ALIGNMENT_OPTIMAL up to this size
+		CLASS_SMALL_COUNT = CLASS_SMALL_MAX / ALIGNMENT_OPTIMAL,
+		CLASS_POW2_FIRST = 11, // Then power of 2 classes, from 2 KiB
+		CLASS_POW2_LAST = 20, // to 1 MiB
+		CLASS_COUNT = CLASS_SMALL_COUNT + (CLASS_POW2_LAST - CLASS_POW2_FIRST + 1)
+	};
+
+	enum
+	{
+		PAGE_NONE = 0, // Page is not used, otherwise page class is the size class + 1
+		PAGE_LARGE = 0xFFFF // First page of a large allocation
+	};
+
+	enum
+	{
+		MAX_PAGES = 64 * 1024, // Max arena pages, 128 GiB with 2 MiB pages
+		MAX_ORPHANS = 256, // Max heaps of finished threads waiting for adoption, more are merged
+		SLICE_SIZE = 64 * 1024, // Bytes of a class page a thread heap takes at once
+		BOOTSTRAP_SIZE = 1024 * 1024 // Memory used while the arena is initializing
+	};
+
+	enum { STATE_NONE, STATE_INIT, STATE_READY, STATE_FALLBACK };
+
+	// Default arena size
+	const SIZE_T DEFAULT_ARENA_SIZE = (SIZE_T)1 << 30;
+
+	// Per-thread size-class heap
+	// This is a POD, so it lives in static TLS with no construction
+	struct ThreadHeap
+	{
+		// Recycled blocks linked-list per class
+		void* freeList[CLASS_COUNT];
+
+		// Next never used block in the current class slice
+		UINTPTR cursor[CLASS_COUNT];
+
+		// End of the current class slice
+		UINTPTR end[CLASS_COUNT];
+
+		// True if the heap is in use by its thread
+		uint32 active;
+	};
+
+	// Simple spin lock, OSMemory segments requests are not thread safe
+	class SpinLock
+	{
+	public:
+		SpinLock(std::atomic_flag& flag) : flag(flag)
+		{
+			while (flag.test_and_set(std::memory_order_acquire))
+				sched_yield();
+		}
+
+		~SpinLock()
+		{
+			flag.clear(std::memory_order_release);
+		}
+
+	private:
+		std::atomic_flag& flag;
+	};
+
+	// Interposer state
+	std::atomic<uint32> state(STATE_NONE);
+	std::atomic_flag segmentLock = ATOMIC_FLAG_INIT;
+
+	// Arena range
+	UINTPTR arenaBase = 0;
+	SIZE_T arenaSize = 0;
+	SIZE_T pageSize = 0;
+
+	// Class of every arena page, and pages count of large allocations
+	uint16 pageClass[MAX_PAGES];
+	uint32 largePages[MAX_PAGES];
+
+	// Unsliced range of the current page of every class, guarded by segmentLock
+	UINTPTR classCursor[CLASS_COUNT];
+	UINTPTR classEnd[CLASS_COUNT];
+
+	// libc malloc_usable_size, for blocks served by libc
+	size_t (*libcUsableSize)(void*) = nullptr;
+
+	// Heaps of finished threads
+	ThreadHeap orphans[MAX_ORPHANS];
+	uint32 orphanCount = 0;
+
+	// Thread exit notification key
+	pthread_key_t heapKey;
+
+	// Bootstrap memory
+	alignas(ALIGNMENT_OPTIMAL) ubyte bootstrap[BOOTSTRAP_SIZE];
+	std::atomic<SIZE_T> bootstrapUsed(0);
+
+	// Stats
+	std::atomic<SIZE_T> classSegments(0);
+	std::atomic<SIZE_T> largeSegments(0);
+	std::atomic<SIZE_T> largePeak(0);
+
+	__thread ThreadHeap heap __attribute__((tls_model("initial-exec")));
+
+	// Return size class index of a size in bytes
+	_INLINE uint32 ClassOf(SIZE_T size)
+	{
+		if (size <= CLASS_SMALL_MAX)
+			return size ? (uint32)((size - 1) / ALIGNMENT_OPTIMAL) : 0;
+
+		uint32 shift = 64 - __builtin_clzll((uint64)size - 1);
+		return CLASS_SMALL_COUNT + (shift - CLASS_POW2_FIRST);
+	}
+
+	// Return block size of a size class
+	_INLINE SIZE_T ClassSize(uint32 cls)
+	{
+		return cls < CLASS_SMALL_COUNT ? 
+			(SIZE_T)(cls + 1) * ALIGNMENT_OPTIMAL : (SIZE_T)1 << (cls - CLASS_SMALL_COUNT + CLASS_POW2_FIRST);
+	}
+
+	_INLINE bool IsBootstrap(const void* ptr)
+	{
+		return (UINTPTR)ptr - (UINTPTR)bootstrap < BOOTSTRAP_SIZE;
+	}
+
+	_INLINE bool IsArena(const void* ptr)
+	{
+		return (UINTPTR)ptr - arenaBase < arenaSize;
+	}
+
+	_INLINE SIZE_T PageIndex(const void* ptr)
+	{
+		return ((UINTPTR)ptr - arenaBase) / pageSize;
+	}
+
+	// Allocate from bootstrap memory, the block size is stored before the block
+	void* BootstrapAlloc(SIZE_T size, SIZE_T alignment = ALIGNMENT_OPTIMAL)
+	{
+		if (alignment < ALIGNMENT_OPTIMAL)
+			alignment = ALIGNMENT_OPTIMAL;
+
+		SIZE_T request = size + alignment + ALIGNMENT_OPTIMAL;
+		SIZE_T offset = bootstrapUsed.fetch_add(request);
+		if (offset + request > BOOTSTRAP_SIZE)
+			return nullptr;
+
+		void* ptr = Align((void*)(bootstrap + offset + ALIGNMENT_OPTIMAL), (int32)alignment);
+		MemWrite(size, ptr, -(SSIZE_T)sizeof(SIZE_T));
+		return ptr;
+	}
+
+	// Turn the rest of the heap slices into recycled blocks, so heaps can be merged
+	//
+	// @param: h - The heap
+	// @param: tails - Receives the last recycled block of every class
+	void RecycleSlices(ThreadHeap& h, void** tails)
+	{
+		for (uint32 cls = 0; cls < CLASS_COUNT; cls++)
+		{
+			SIZE_T size = ClassSize(cls);
+			for (; h.cursor[cls] + size <= h.end[cls]; h.cursor[cls] += size)
+			{
+				MemWrite(h.freeList[cls], (void*)h.cursor[cls], 0);
+				h.freeList[cls] = (void*)h.cursor[cls];
+			}
+
+			void* tail = h.freeList[cls];
+			while (tail && MemRead<void*>(tail, 0))
+				tail = MemRead<void*>(tail, 0);
+			tails[cls] = tail;
+		}
+	}
+
+	// Thread is finished, leave its heap to the next thread,
+	// when the orphans are full the heap blocks are merged into the last orphan
+	void ReleaseHeap(void*)
+	{
+		{
+			SpinLock guard(segmentLock);
+			if (orphanCount < MAX_ORPHANS)
+			{
+				orphans[orphanCount++] = heap;
+				memset(&heap, 0, sizeof(ThreadHeap));
+				return;
+			}
+		}
+
+		// Walk the free lists out of the lock
+		void* tails[CLASS_COUNT];
+		RecycleSlices(heap, tails);
+
+		{
+			SpinLock guard(segmentLock);
+			if (orphanCount < MAX_ORPHANS) // Orphans were adopted meanwhile
+				orphans[orphanCount++] = heap;
+			else
+			{
+				ThreadHeap& into = orphans[orphanCount - 1];
+				for (uint32 cls = 0; cls < CLASS_COUNT; cls++)
+				{
+					if (!tails[cls])
+						continue;
+
+					MemWrite(into.freeList[cls], tails[cls], 0);
+					into.freeList[cls] = heap.freeList[cls];
+				}
+			}
+		}
+		memset(&heap, 0, sizeof(ThreadHeap));
+	}
+
+	// Create the arena, called once by the first allocation
+	void Init()
+	{
+		uint32 expected = STATE_NONE;
+		if (!state.compare_exchange_strong(expected, STATE_INIT))
+			return;
+
+		SIZE_T size = DEFAULT_ARENA_SIZE;
+		const char* env = getenv("BOXYTO_ARENA_SIZE");
+		if (env && strtoull(env, nullptr, 0))
+			size = strtoull(env, nullptr, 0);
+
+		// Allocations made by OSMemory::Init & dlsym use the bootstrap memory
+		libcUsableSize = (size_t(*)(void*))dlsym(RTLD_NEXT, "malloc_usable_size");
+
+		pageSize = OSMemory::GetPageSize();
+		if (size > pageSize * MAX_PAGES)
+			size = pageSize * MAX_PAGES;
+		OSMemory::Init(size);
+
+		if (!OSMemory::GetMemory())
+		{
+			// LOG: No arena, use libc allocator
+			state.store(STATE_FALLBACK, std::memory_order_release);
+			return;
+		}
+
+		pthread_key_create(&heapKey, ReleaseHeap);
+		arenaBase = (UINTPTR)OSMemory::GetMemory();
+		arenaSize = (SIZE_T)OSMemory::GetPageCount() * pageSize;
+		state.store(STATE_READY, std::memory_order_release);
+	}
+
+	// Return this thread heap, adopting a finished thread heap if any
+	_INLINE ThreadHeap& GetHeap()
+	{
+		if (!heap.active)
+		{
+			{
+				SpinLock guard(segmentLock);
+				if (orphanCount)
+					heap = orphans[--orphanCount];
+			}
+
+			heap.active = true;
+			pthread_setspecific(heapKey, &heap);
+		}
+
+		return heap;
+	}
+
+	// Request segment of pages from OSMemory
+	_INLINE void* RequestSegment(SIZE_T size)
+	{
+		SpinLock guard(segmentLock);
+		return OSMemory::RequestSegment(size);
+	}
+
+	// Take a slice of the shared page of a class, so a thread holds only a slice of every class it uses
+	//
+	// @param: h - The heap to take the slice
+	// @param: cls - The size class
+	// @return: false if out of memory
+	bool TakeSlice(ThreadHeap& h, uint32 cls)
+	{
+		SIZE_T size = ClassSize(cls);
+		SIZE_T slice = size < SLICE_SIZE ? (SLICE_SIZE / size) * size : size;
+
+		SpinLock guard(segmentLock);
+		if (classCursor[cls] + size > classEnd[cls]) // Take a new page for the class
+		{
+			void* segment = OSMemory::RequestSegment(pageSize);
+			if (!segment)
+				return false; // LOG: OUT OF MEMORY
+
+			pageClass[PageIndex(segment)] = (uint16)(cls + 1);
+			classCursor[cls] = (UINTPTR)segment;
+			classEnd[cls] = (UINTPTR)segment + (pageSize / size) * size;
+			++classSegments;
+		}
+
+		// The page rest is a multiple of the class size
+		if (slice > classEnd[cls] - classCursor[cls])
+			slice = classEnd[cls] - classCursor[cls];
+
+		h.cursor[cls] = classCursor[cls];
+		h.end[cls] = classCursor[cls] + slice;
+		classCursor[cls] += slice;
+		return true;
+	}
+
+	// Allocate a block of size class
+	void* AllocClass(uint32 cls)
+	{
+		ThreadHeap& h = GetHeap();
+
+		void* block = h.freeList[cls];
+		if (block) // Read block from recycle...
+		{
+			h.freeList[cls] = MemRead<void*>(block, 0);
+			return block;
+		}
+
+		SIZE_T size = ClassSize(cls);
+		if (h.cursor[cls] + size > h.end[cls] && !TakeSlice(h, cls))
+			return nullptr;
+
+		block = (void*)h.cursor[cls];
+		h.cursor[cls] += size;
+		return block;
+	}
+
+	// Allocate own segment of pages
+	void* AllocLarge(SIZE_T size)
+	{
+		void* segment = RequestSegment(size);
+		if (!segment)
+			return nullptr; // LOG: OUT OF MEMORY
+
+		SIZE_T index = PageIndex(segment);
+		pageClass[index] = PAGE_LARGE;
+		largePages[index] = (uint32)((size + pageSize - 1) / pageSize);
+
+		SIZE_T count = ++largeSegments;
+		SIZE_T peak = largePeak.load();
+		while (count > peak && !largePeak.compare_exchange_weak(peak, count))
+			;
+
+		return segment;
+	}
+
+	// Return state, initializing the arena if required
+	_INLINE uint32 CheckState()
+	{
+		uint32 current = state.load(std::memory_order_acquire);
+		if (current == STATE_NONE)
+		{
+			Init();
+			current = state.load(std::memory_order_acquire);
+		}
+
+		return current;
+	}
+
+	void* Allocate(SIZE_T size)
+	{
+		switch (CheckState())
+		{
+		case STATE_READY: break;
+		case STATE_FALLBACK: return __libc_malloc(size);
+		default: return BootstrapAlloc(size);
+		}
+
+		void* ptr = size <= ((SIZE_T)1 << CLASS_POW2_LAST) ? AllocClass(ClassOf(size)) : AllocLarge(size);
+
+		// LOG: Arena is exhausted, libc serves the request
+		return ptr ? ptr : __libc_malloc(size);
+	}
+
+	void* AllocateAligned(SIZE_T alignment, SIZE_T size)
+	{
+		if (alignment <= ALIGNMENT_OPTIMAL)
+			return Allocate(size);
+
+		switch (CheckState())
+		{
+		case STATE_READY: break;
+		case STATE_FALLBACK: return __libc_memalign(alignment, size);
+		default: return BootstrapAlloc(size, alignment);
+		}
+
+		// Power of 2 class blocks are aligned to their size, segments are aligned to the page size
+		void* ptr = nullptr;
+		SIZE_T request = size > alignment ? size : alignment;
+		if (request <= ((SIZE_T)1 << CLASS_POW2_LAST))
+		{
+			SIZE_T pow2 = (SIZE_T)1 << (64 - __builtin_clzll((uint64)request - 1));
+			ptr = AllocClass(ClassOf(pow2));
+		}
+		else if (alignment <= pageSize)
+			ptr = AllocLarge(size);
+
+		// LOG: Arena is exhausted or the alignment is larger than a page, libc serves the request
+		return ptr ? ptr : __libc_memalign(alignment, size);
+	}
+
+	// Return the usable size of a block
+	SIZE_T UsableSize(const void* ptr)
+	{
+		if (IsBootstrap(ptr))
+			return MemRead<SIZE_T>(ptr, -(SSIZE_T)sizeof(SIZE_T));
+
+		if (!IsArena(ptr))
+			return libcUsableSize ? libcUsableSize((void*)ptr) : 0;
+
+		SIZE_T index = PageIndex(ptr);
+		uint16 cls = pageClass[index];
+		if (cls == PAGE_LARGE)
+			return largePages[index] * pageSize;
+
+		return ClassSize(cls - 1);
+	}
+
+	void Free(void* ptr)
+	{
+		// Bootstrap memory is never released
+		if (!ptr || IsBootstrap(ptr))
+			return;
+
+		if (!IsArena(ptr))
+		{
+			__libc_free(ptr);
+			return;
+		}
+
+		SIZE_T index = PageIndex(ptr);
+		uint16 cls = pageClass[index];
+		if (cls == PAGE_LARGE)
+		{
+			pageClass[index] = PAGE_NONE;
+			--largeSegments;
+
+			SpinLock guard(segmentLock);
+			OSMemory::ReleaseSegment(ptr);
+			return;
+		}
+
+		// Recycle block in this thread heap
+		ThreadHeap& h = GetHeap();
+		MemWrite(h.freeList[cls - 1], ptr, 0);
+		h.freeList[cls - 1] = ptr;
+	}
+
+	void* Reallocate(void* ptr, SIZE_T size)
+	{
+		if (!ptr)
+			return Allocate(size);
+
+		if (!size)
+		{
+			Free(ptr);
+			return nullptr;
+		}
+
+		if (!IsBootstrap(ptr) && !IsArena(ptr))
+			return __libc_realloc(ptr, size);
+
+		// Keep the block if the new size still fits it well
+		SIZE_T oldSize = UsableSize(ptr);
+		if (size <= oldSize && size > oldSize / 2)
+			return ptr;
+
+		void* result = Allocate(size);
+		if (result)
+		{
+			Memcopy(result, ptr, size < oldSize ? size : oldSize);
+			Free(ptr);
+		}
+
+		return result;
+	}
+
+	// Write unsigned value to stderr, no allocations
+	void PrintValue(const char* name, SIZE_T value)
+	{
+		char buffer[32];
+		int32 index = sizeof(buffer);
+		buffer[--index] = '\n';
+		do
+		{
+			buffer[--index] = (char)('0' + value % 10);
+			value /= 10;
+		} while (value);
+
+		ssize_t result = write(STDERR_FILENO, name, strlen(name));
+		result = write(STDERR_FILENO, buffer + index, sizeof(buffer) - index);
+		(void)result;
+	}
+
+	// Print stats at exit if requested
+	__attribute__((destructor)) void PrintStats()
+	{
+		if (!getenv("BOXYTO_MALLOC_STATS") || state.load() != STATE_READY)
+			return;
+
+		PrintValue("boxyto: page size: ", pageSize);
+		PrintValue("boxyto: arena pages: ", OSMemory::GetPageCount());
+		PrintValue("boxyto: size class segments: ", classSegments.load());
+		PrintValue("boxyto: large segments in use: ", largeSegments.load());
+		PrintValue("boxyto: large segments peak: ", largePeak.load());
+		PrintValue("boxyto: bootstrap bytes: ", bootstrapUsed.load());
+	}
+}
+
+/*****************
+ *	C ALLOCATOR
+ *****************/
+
+extern "C"
+{
+	void* malloc(size_t size)
+	{
+		void* ptr = Allocate(size);
+		if (!ptr)
+			errno = ENOMEM;
+		return ptr;
+	}
+
+	void free(void* ptr)
+	{
+		Free(ptr);
+	}
+
+	void* calloc(size_t count, size_t size)
+	{
+		size_t total;
+		if (__builtin_mul_overflow(count, size, &total))
+		{
+			errno = ENOMEM;
+			return nullptr;
+		}
+
+		void* ptr = malloc(total);
+		if (ptr)
+			Memfill(ptr, 0, total);
+		return ptr;
+	}
+
+	void* realloc(void* ptr, size_t size)
+	{
+		void* result = Reallocate(ptr, size);
+		if (!result && size)
+			errno = ENOMEM;
+		return result;
+	}
+
+	void* reallocarray(void* ptr, size_t count, size_t size)
+	{
+		size_t total;
+		if (__builtin_mul_overflow(count, size, &total))
+		{
+			errno = ENOMEM;
+			return nullptr;
+		}
+
+		return realloc(ptr, total);
+	}
+
+	int posix_memalign(void** result, size_t alignment, size_t size)
+	{
+		if (!alignment || (alignment & (alignment - 1)) || alignment % sizeof(void*))
+			return EINVAL;
+
+		void* ptr = AllocateAligned(alignment, size);
+		if (!ptr)
+			return ENOMEM;
+
+		*result = ptr;
+		return 0;
+	}
+
+	void* aligned_alloc(size_t alignment, size_t size)
+	{
+		if (!alignment || (alignment & (alignment - 1)))
+		{
+			errno = EINVAL;
+			return nullptr;
+		}
+
+		void* ptr = AllocateAligned(alignment, size);
+		if (!ptr)
+			errno = ENOMEM;
+		return ptr;
+	}
+
+	void* memalign(size_t alignment, size_t size)
+	{
+		return aligned_alloc(alignment, size);
+	}
+
+	void* valloc(size_t size)
+	{
+		return aligned_alloc(sysconf(_SC_PAGESIZE), size);
+	}
+
+	void* pvalloc(size_t size)
+	{
+		size_t page = sysconf(_SC_PAGESIZE);
+		return aligned_alloc(page, (size + page - 1) & ~(page - 1));
+	}
+
+	size_t malloc_usable_size(void* ptr)
+	{
+		return ptr ? UsableSize(ptr) : 0;
+	}
+}
+
+/*****************
+ *	C++ ALLOCATOR
+ *****************/
+
+void* operator new(std::size_t size)
+{
+	void* ptr = Allocate(size);
+	if (!ptr)
+		throw std::bad_alloc();
+	return ptr;
+}
+
+void* operator new[](std::size_t size)
+{
+	return operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+	return Allocate(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+	return Allocate(size);
+}
+
+void operator delete(void* ptr) noexcept
+{
+	Free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+	Free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+	Free(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept
+{
+	Free(ptr);
+}
+
+void operator delete(void* ptr, const std::nothrow_t&) noexcept
+{
+	Free(ptr);
+}
+
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept
+{
+	Free(ptr);
+}
+
+#if __cplusplus >= 201703L
+
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+	void* ptr = AllocateAligned((SIZE_T)alignment, size);
+	if (!ptr)
+		throw std::bad_alloc();
+	return ptr;
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment)
+{
+	return operator new(size, alignment);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+	return AllocateAligned((SIZE_T)alignment, size);
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+	return AllocateAligned((SIZE_T)alignment, size);
+}
+
+void operator delete(void* ptr, std::align_val_t) noexcept
+{
+	Free(ptr);
+}
+
+void operator delete[](void* ptr, std::align_val_t) noexcept
+{
+	Free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept
+{
+	Free(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t, std::align_val_t) noexcept
+{
+	Free(ptr);
+}
+
+void operator delete(void* ptr, std::align_val_t, const std::nothrow_t&) noexcept
+{
+	Free(ptr);
+}
+
+void operator delete[](void* ptr, std::align_val_t, const std::nothrow_t&) noexcept
+{
+	Free(ptr);
+}
+
+#endif
+
+#endif // __linux__
@@ -25,26 +25,34 @@ SOFTWARE.
 #pragma once
 
 #include "../system.h"
+#include "../Template/Common.h"
+#include "SimdMemoryOps.h"
 #include <cstring>
 
 namespace Everest
 {
-	// System memcpy  
-	static void* Memcopy(void* dst, void* src, const SIZE_T size)
+	// memcpy, using the best SIMD kernel of the running cpu
+	static void* Memcopy(void* dst, const void* src, const SIZE_T size)
 	{
-		return memcpy(dst, src, size);
+		return SimdMemory::Copy(dst, src, size);
 	}
 	 
-	// System memmove
-	static void* Memmove(void* dst, void* src, const SIZE_T size)
+	// memmove, using the best SIMD kernel of the running cpu
+	static void* Memmove(void* dst, const void* src, const SIZE_T size)
 	{
-		return memmove(dst, src, size);
+		return SimdMemory::Move(dst, src, size);
 	}
 
-	// System memcmp
+	// memset, using the best SIMD kernel of the running cpu
+	static void* Memfill(void* dst, int32 value, const SIZE_T size)
+	{
+		return SimdMemory::Fill(dst, value, size);
+	}
+
+	// memcmp, using the best SIMD kernel of the running cpu
 	static int Memcmp(const void* p1, const void* p2, SIZE_T size)
 	{
-		return memcmp(p1, p2, size);
+		return SimdMemory::Compare(p1, p2, size);
 	}
 
 	// Get an offset memory location before or after given pointer
@@ -146,13 +154,41 @@ namespace Everest
 	// @param: dest - The start pointer to construct
 	// @param: value - The element's value to construct with
 	// @param: count - Element count
-	template < class T, class ... Args >
-	_INLINE void ConstructRange(T* dest, const T& value, uint32 count)
+	template < class T >
+	_INLINE typename EnableIf<!IsTriviallyCopyable<T>::value>::Type 
+		ConstructRange(T* dest, const T& value, uint32 count)
 	{
 		while (count--)
 			new (dest++) T(value);
 	}
 
+	// Construct contiguous elements from the same type, in memory, usful for copy constructors
+	// Trivially copyable version, all bytes zero values (or byte size types) are a single memset,
+	// other values are plain copies the compiler can vectorize
+	//
+	// @param: dest - The start pointer to construct
+	// @param: value - The element's value to construct with
+	// @param: count - Element count
+	template < class T >
+	_INLINE typename EnableIf<IsTriviallyCopyable<T>::value>::Type 
+		ConstructRange(T* dest, const T& value, uint32 count)
+	{
+		const ubyte* bytes = reinterpret_cast<const ubyte*>(&value);
+
+		bool sameBytes = true;
+		for (SIZE_T i = 1; i < sizeof(T) && sameBytes; ++i)
+			sameBytes = bytes[i] == bytes[0];
+
+		if (sameBytes && (sizeof(T) == 1 || bytes[0] == 0))
+		{
+			Memfill(dest, bytes[0], sizeof(T) * count);
+			return;
+		}
+
+		while (count--)
+			new (dest++) T(value);
+	}
+
 	// Linear constructing items in dest from items in source, for a range of elements from a range of elements
 	// Elements should be the same type
 	//
@@ -161,21 +197,37 @@ namespace Everest
 	// @param: value - The element's value to construct with
 	// @param: count - Element count
 	template < class T>
-	_INLINE void ConstructRangeFromRange(T* source, T* dest, uint32 count, uint32 start = 0)
+	_INLINE typename EnableIf<!IsTriviallyCopyable<T>::value>::Type 
+		ConstructRangeFromRange(const T* source, T* dest, uint32 count, uint32 start = 0)
 	{
 		while (count--)
 		{
-			new (dest + (start++)) ElementType(*source);
+			new (dest + (start++)) T(*source);
 			++source;
 		}
 	}
 
+	// Linear constructing items in dest from items in source, for a range of elements from a range of elements
+	// Trivially copyable version, a single memory copy
+	//
+	// @param: source - Source to construct from
+	// @param: dest - The start pointer to construct
+	// @param: value - The element's value to construct with
+	// @param: count - Element count
+	template < class T>
+	_INLINE typename EnableIf<IsTriviallyCopyable<T>::value>::Type 
+		ConstructRangeFromRange(const T* source, T* dest, uint32 count, uint32 start = 0)
+	{
+		Memmove(dest + start, source, sizeof(T) * count);
+	}
+
 	// Calls an element destructor for range of elements
 	//
 	// @param: startElement - pointer to the first element to destruct
 	// @param: count(1) - how many elements to destruct
 	template< class T >
-	_INLINE void Destroy(T* startElement, uint32 count = 1)
+	_INLINE typename EnableIf<!IsTriviallyDestructible<T>::value>::Type 
+		Destroy(T* startElement, uint32 count = 1)
 	{
 		while (count--)
 		{
@@ -183,4 +235,14 @@ namespace Everest
 			++startElement;
 		}
 	}
+
+	// Calls an element destructor for range of elements
+	// Trivially destructible version, nothing to do
+	//
+	// @param: startElement - pointer to the first element to destruct
+	// @param: count(1) - how many elements to destruct
+	template< class T >
+	_INLINE typename EnableIf<IsTriviallyDestructible<T>::value>::Type 
+		Destroy(T*, uint32 = 1)
+	{}
 }
@@ -0,0 +1,305 @@
+/*****************************************************************************
+The MIT License(MIT)
+
+Copyright(c) 2016 Amr Esam
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*********************************************************************************/
+#pragma once
+
+#include "../system.h"
+#include "StaticSegment.h"
+#include "DynamicSegment.h"
+#include "MemoryOps.h"
+
+/* For std::shared_ptr */
+#include <memory>
+
+/* For std::bad_alloc */
+#include <new>
+
+// std::pmr is a C++ 17 feature, adapters are available only if the library has it
+#if (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L) || __cplusplus >= 201703L
+#if defined(__has_include)
+#if __has_include(<memory_resource>)
+#define _BOXYTO_PMR_
+#endif
+#endif
+#endif
+
+#ifdef _BOXYTO_PMR_
+
+#include <memory_resource>
+
+namespace Everest
+{
+	// std::pmr::memory_resource over a StaticSegment
+	// This is a monotonic resource, deallocate does nothing
+	// and memory is released only with the segment
+	class StaticSegmentResource :
+		public std::pmr::memory_resource
+	{
+	public:
+
+		// Create from segment manager
+		explicit StaticSegmentResource(std::shared_ptr<StaticSegment> segment) :
+			segmentManager(segment)
+		{}
+
+		// Get Segment manager used by this resource
+		std::shared_ptr<StaticSegment> GetSegmentManager() const
+		{
+			return segmentManager;
+		}
+
+	protected:
+
+		void* do_allocate(std::size_t bytes, std::size_t alignment) override
+		{
+			void* result = segmentManager->Alloc(bytes, (uint32)alignment);
+			if (!result)
+				throw std::bad_alloc(); // LOG: OUT OF MEMORY
+
+			return result;
+		}
+
+		void do_deallocate(void*, std::size_t, std::size_t) override
+		{
+			/* Nothing to do here */
+		}
+
+		bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+		{
+			return this == &other;
+		}
+
+	private:
+
+		// Segment manager instance
+		std::shared_ptr<StaticSegment> segmentManager;
+	};
+
+	// std::pmr::memory_resource over a DynamicSegment
+	// General purpose resource, deallocate releases memory back to the segment.
+	// Allocations are accessed by raw pointers, so the segment should not be defragmented
+	// while the resource is in use
+	class DynamicSegmentResource :
+		public std::pmr::memory_resource
+	{
+	public:
+
+		// Create from segment manager
+		explicit DynamicSegmentResource(std::shared_ptr<DynamicSegment> segment) :
+			segmentManager(segment)
+		{}
+
+		// Get Segment manager used by this resource
+		std::shared_ptr<DynamicSegment> GetSegmentManager() const
+		{
+			return segmentManager;
+		}
+
+	protected:
+
+		void* do_allocate(std::size_t bytes, std::size_t alignment) override
+		{
+			UINTPTR handle = segmentManager->Alloc(bytes, (uint32)alignment);
+			if (!handle)
+				throw std::bad_alloc(); // LOG: OUT OF MEMORY
+
+			return DynamicSegment::PointerOf(handle);
+		}
+
+		void do_deallocate(void* ptr, std::size_t, std::size_t) override
+		{
+			segmentManager->Dealloc(ptr);
+		}
+
+		// Two resources are equal if they consume the same segment
+		bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+		{
+			const DynamicSegmentResource* resource = dynamic_cast<const DynamicSegmentResource*>(&other);
+			return resource && resource->segmentManager == segmentManager;
+		}
+
+	private:
+
+		// Segment manager instance
+		std::shared_ptr<DynamicSegment> segmentManager;
+	};
+
+	// std::pmr::memory_resource with a pool of fixed size blocks, like the node allocators.
+	// Blocks are carved from chunks allocated by a DynamicSegment and recycled on deallocate,
+	// requests larger than a block go directly to the segment.
+	// Chunks are released to the segment when the resource is destructed
+	class NodePoolResource :
+		public std::pmr::memory_resource
+	{
+	public:
+
+		// Create from segment manager
+		//
+		// @param: segment - Segment manager to allocate chunks from
+		// @param: blockSize - Pool block size in bytes, larger requests are not pooled
+		// @param: blocksPerChunk(DEFAULT_CONTAINER_CAPACITY) - Count of blocks allocated at once
+		NodePoolResource(std::shared_ptr<DynamicSegment> segment, SIZE_T blockSize, 
+			uint32 blocksPerChunk = DEFAULT_CONTAINER_CAPACITY) :
+			segmentManager(segment),
+			blockSize((SIZE_T)Align((void*)(blockSize < sizeof(void*) ? sizeof(void*) : blockSize), ALIGNMENT_OPTIMAL)),
+			blocksPerChunk(blocksPerChunk),
+			chunkHead((UINTPTR)nullptr),
+			recycledHead(nullptr),
+			nextFree(nullptr),
+			nextFreeCount(0)
+		{}
+
+		// Delete equality constructor
+		NodePoolResource(const NodePoolResource&) = delete;
+		NodePoolResource& operator= (const NodePoolResource&) = delete;
+
+		// Release all chunks
+		~NodePoolResource()
+		{
+			Release();
+		}
+
+		// Release all chunks back to the segment
+		// All blocks allocated from this pool are no longer valid
+		void Release()
+		{
+			while (chunkHead)
+			{
+				UINTPTR next = MemRead<UINTPTR>(DynamicSegment::PointerOf(chunkHead), 0);
+				segmentManager->Dealloc(chunkHead);
+				chunkHead = next;
+			}
+
+			recycledHead = nullptr;
+			nextFree = nullptr;
+			nextFreeCount = 0;
+		}
+
+		// Return the pool block size in bytes
+		_INLINE SIZE_T GetBlockSize() const
+		{
+			return blockSize;
+		}
+
+		// Get Segment manager used by this resource
+		std::shared_ptr<DynamicSegment> GetSegmentManager() const
+		{
+			return segmentManager;
+		}
+
+	protected:
+
+		void* do_allocate(std::size_t bytes, std::size_t alignment) override
+		{
+			// Not a pool block, allocate from the segment
+			if (bytes > blockSize || alignment > ALIGNMENT_OPTIMAL)
+			{
+				UINTPTR handle = segmentManager->Alloc(bytes, (uint32)alignment);
+				if (!handle)
+					throw std::bad_alloc(); // LOG: OUT OF MEMORY
+
+				return DynamicSegment::PointerOf(handle);
+			}
+
+			if (recycledHead) // Read block from recycle...
+			{
+				void* result = recycledHead;
+				recycledHead = MemRead<void*>(result, 0);
+				return result;
+			}
+
+			// Allocate new chunk if no free blocks
+			if (!nextFreeCount && !NewChunk())
+				throw std::bad_alloc(); // LOG: OUT OF MEMORY
+
+			void* result = nextFree;
+			nextFree = Offset(nextFree, blockSize);
+			--nextFreeCount;
+			return result;
+		}
+
+		void do_deallocate(void* ptr, std::size_t bytes, std::size_t alignment) override
+		{
+			// Not a pool block, release to the segment
+			if (bytes > blockSize || alignment > ALIGNMENT_OPTIMAL)
+			{
+				segmentManager->Dealloc(ptr);
+				return;
+			}
+
+			// Recycle block
+			MemWrite(recycledHead, ptr, 0);
+			recycledHead = ptr;
+		}
+
+		bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+		{
+			return this == &other;
+		}
+
+	private:
+
+		// Allocate a new chunk of blocks and link it with other chunks
+		// The first block of every chunk stores the next chunk handle
+		//
+		// @return: true if allocated
+		bool NewChunk()
+		{
+			UINTPTR chunk = segmentManager->Alloc(blockSize * (blocksPerChunk + 1), ALIGNMENT_OPTIMAL);
+			if (!chunk)
+				return false;
+
+			void* memory = DynamicSegment::PointerOf(chunk);
+			MemWrite(chunkHead, memory, 0);
+			chunkHead = chunk;
+
+			nextFree = Offset(memory, blockSize);
+			nextFreeCount = blocksPerChunk;
+			return true;
+		}
+
+		// Segment manager instance
+		std::shared_ptr<DynamicSegment> segmentManager;
+
+		// Pool block size, aligned to ALIGNMENT_OPTIMAL
+		SIZE_T blockSize;
+
+		// Blocks count per chunk
+		uint32 blocksPerChunk;
+
+		// Chunks linked-list head
+		UINTPTR chunkHead;
+
+		// Recycled blocks linked-list head
+		void* recycledHead;
+
+		// Next never used block in the current chunk
+		void* nextFree;
+
+		// Count of never used blocks in the current chunk
+		uint32 nextFreeCount;
+	};
+}
+
+#endif // _BOXYTO_PMR_
@@ -61,7 +61,10 @@ namespace Everest
 		// @param: size - Configured size to allocate from system memory in huge pages,
 		//                size MUST be a multiple of the large-page minimum
 		static void Init(SIZE_T size)
-		{ 
+		{
+			// Select memory kernels for this cpu
+			SimdMemory::Init();
+ 
 			// Calc how many system pages we need
 			pageCount = CalcPages(size);
 			
@@ -138,6 +141,9 @@ namespace Everest
 
 		static void Init(SIZE_T size)
 		{
+			// Select memory kernels for this cpu
+			SimdMemory::Init();
+
 			// Calc how many system pages we need
 			pageCount = CalcPages(size);
 
@@ -172,11 +178,18 @@ namespace Everest
 
 		static void Init(SIZE_T size)
 		{
+			// Select memory kernels for this cpu
+			SimdMemory::Init();
+
 			// Calc how many system pages we need
 			pageCount = CalcPages(size);
 
 			// Try allocate Huge Pages
-			memory = memalign(sysconf(_SC_PAGESIZE), pageCount * GetPageSize());
+			memory = AllocHuge(pageCount * GetPageSize());
+
+			// Huge allocate failed, try normal allocation instead
+			if (!memory)
+				memory = AllocAligned(pageCount * GetPageSize());
 
 			if (memory == nullptr)
 			{
@@ -187,6 +200,49 @@ namespace Everest
 			CreateMappingList();
 		}
 
+		// Allocate huge segmants from OS using explicit huge pages,
+		// this requires huge pages reserved by the system (vm.nr_hugepages)
+		//
+		// @param: size - Size of segmants to allocate
+		// @return: Pointer to the allocated memory
+		static void* AllocHuge(SIZE_T size)
+		{
+#ifdef MAP_HUGETLB
+			void* mem = mmap(nullptr, size, PROT_READ | PROT_WRITE, 
+				MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+			if (mem != MAP_FAILED)
+				return mem;
+#endif
+			// LOG: No huge pages available
+			return nullptr;
+		}
+
+		// Allocate normal pages from OS aligned to the huge page size,
+		// and ask the kernel to back them with transparent huge pages
+		//
+		// @param: size - Size of segmants to allocate
+		// @return: Pointer to the allocated memory
+		static void* AllocAligned(SIZE_T size)
+		{
+			SIZE_T pageSize = GetPageSize();
+			void* raw = mmap(nullptr, size + pageSize, PROT_READ | PROT_WRITE, 
+				MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+			if (raw == MAP_FAILED)
+				return nullptr;
+
+			// Unmap the unaligned head & tail
+			void* mem = Align(raw, (int32)pageSize);
+			SIZE_T head = (UINTPTR)mem - (UINTPTR)raw;
+			if (head)
+				munmap(raw, head);
+			munmap(Offset(mem, size), pageSize - head);
+
+#ifdef MADV_HUGEPAGE
+			madvise(mem, size, MADV_HUGEPAGE);
+#endif
+			return mem;
+		}
+
 		// Return OS huge page size in bytes
 		static SIZE_T GetPageSize()
 		{
@@ -199,7 +255,7 @@ namespace Everest
 		static void Terminate()
 		{
 			if (memory != nullptr)
-				free(memory);
+				munmap(memory, pageCount * GetPageSize());
 		}
 
 #endif
@@ -219,7 +275,7 @@ namespace Everest
 			// Hold found contiguous pages
 			uint32 found = 0;
 
-			auto& it = pages.begin();
+			auto it = pages.begin();
 			for (; it != pages.end(); it++)
 			{ 
 				if (!it->flags)
@@ -232,7 +288,7 @@ namespace Everest
 						it->flags = true; // Set allocated flag
 
 						// Map memory pointer to this page
-						SIZE_T index = ((SIZE_T)(UINTPTR)it._Ptr - (UINTPTR)pages.data()) / sizeof(PageDesc);
+						SIZE_T index = it - pages.begin();
 						return (Offset(memory, GetPageSize() * index));
 					}
 				}
@@ -254,14 +310,27 @@ namespace Everest
 		{
 			// Map the page where the segment starts
 			SIZE_T index = ((UINTPTR)ptr - (UINTPTR)memory) / GetPageSize();
-			auto& start = pages.begin() + index;
-			auto& end = start + pages[index].count;
+			auto start = pages.begin() + index;
+			auto end = start + pages[index].count;
 			
 			// Reset segment's pages
 			for (; start != end; ++start)
 				*start = PageDesc();
 		}
 
+		// Return the base address of the memory allocated by system,
+		// all segments are inside [GetMemory(), GetMemory() + GetPageCount() * GetPageSize())
+		static void* GetMemory()
+		{
+			return memory;
+		}
+
+		// Return count of system pages allocated by Init
+		static uint32 GetPageCount()
+		{
+			return pageCount;
+		}
+
 	private:
 
 		// Init pages to segments mapping 
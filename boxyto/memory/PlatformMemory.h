@@ -38,5 +38,7 @@ SOFTWARE.
 #else
 	#include <stdlib.h>
 	#include <malloc.h>
+	#include <unistd.h>
+	#include <sys/mman.h>
 
 #endif
\ No newline at end of file
@@ -35,7 +35,7 @@ namespace Everest
 	{
 	public:
 
-		typedef typename Pointer type;
+		typedef Pointer type;
 
 		Pointer() :
 			handle(0)
@@ -99,11 +99,117 @@ namespace Everest
 			return handle;
 		}
 
+		// True if the pointer has a handle, allocators return null pointers when out of memory
+		_INLINE explicit operator bool() const
+		{
+			return handle != 0;
+		}
+
 	private:
 
 		UINTPTR handle;
 	};
 
+	// Pointer to a dynamic segment allocation that caches the resolved address with the defragmentation epoch,
+	// the handle is resolved again only when the epoch changes, so access costs almost as a raw pointer.
+	// IMPORTANT: Get() updates the cache with no synchronization, so a CachedPointer object is used by one thread,
+	// other threads use their own copies. Returned addresses are valid until the next defragmentation,
+	// so segments are not defragmented while other threads use the addresses
+	template <class T>
+	class CachedPointer
+	{
+	public:
+
+		CachedPointer() :
+			handle(0), pointer(nullptr), epoch(DynamicSegment::GetEpoch())
+		{}
+
+		// Constructor that allows pointer creation with handle
+		//
+		// @param: handle - Pointer handle.
+		CachedPointer(UINTPTR handle) :
+			handle(handle), pointer(nullptr), epoch(DynamicSegment::GetEpoch())
+		{
+			Resolve();
+		}
+
+		// Construct from a handle pointer
+		CachedPointer(const Pointer<T>& _other) :
+			CachedPointer(_other.GetHandle())
+		{}
+
+		CachedPointer(const CachedPointer& _other) :
+			handle(_other.handle), pointer(_other.pointer), epoch(_other.epoch)
+		{}
+
+		// Operator for equality check with other pointer,
+		// two pointers are equal if thier handles are equal
+		_INLINE const bool operator== (const CachedPointer& _other) const
+		{
+			return (handle == _other.handle);
+		}
+
+		// Operator check if this pointer is not equal with other pointer,
+		// two pointers are not equal if thier handles are not equal
+		_INLINE bool operator!= (const CachedPointer& _other)
+		{
+			return  (handle != _other.handle);
+		}
+
+		// Operator equal that copy other pointer
+		_INLINE CachedPointer& operator=(const CachedPointer& _other)
+		{
+			if (this != &_other)
+			{
+				handle = _other.handle;
+				pointer = _other.pointer;
+				epoch = _other.epoch;
+			}
+			return *this;
+		}
+
+		// Return the pointer object, resolved again if a defragmentation happened
+		_INLINE T* Get() const
+		{
+			uint32 current = DynamicSegment::GetEpoch();
+			if (epoch != current)
+			{
+				epoch = current;
+				Resolve();
+			}
+
+			return pointer;
+		}
+
+		// pointer access operator
+		_INLINE T* operator->() const
+		{
+			return Get();
+		}
+
+		UINTPTR GetHandle() const
+		{
+			return handle;
+		}
+
+	private:
+
+		// Resolve the handle to the current address
+		_INLINE void Resolve() const
+		{
+			pointer = handle ? (T*)DynamicSegment::PointerOf(handle) : nullptr;
+		}
+
+		UINTPTR handle;
+
+		// Cached address of the handle
+		mutable T* pointer;
+
+		// Defragmentation epoch when the address cached
+		mutable uint32 epoch;
+
+	}; // CachedPointer
+
 	template <class T>
 	class OffsetPointer
 	{
@@ -222,7 +328,7 @@ namespace Everest
 		// Return the pointer object
 		_INLINE ElementType* Get() const
 		{
-			return Parser::Parse<ElementType>(handle);
+			return Parser::template Parse<ElementType>(handle);
 		}
 
 		// pointer access operator
@@ -35,14 +35,67 @@ SOFTWARE.
 
 namespace Everest
 {
+	// Nodes pool of PoolNodeAllocators, shared by the copies of an allocator (rebound copies too),
+	// so containers created from the same allocator can move nodes between them.
+	// The pool is allocated by the first allocator Init for its node type,
+	// and it is released to its segment with the last allocator.
+	// The pool is not thread safe, containers sharing a pool must be used by one thread at a time
+	struct NodePool
+	{
+		// Create an empty pool, allocated by the first Init
+		//
+		// @param: segment - Segment manager to allocate the pool from
+		// @param: capacity - Count of nodes to allocate first
+		NodePool(std::shared_ptr<DynamicSegment> segment, uint32 capacity) :
+			segmentManager(segment),
+			data((UINTPTR)nullptr),
+			recycledHeadOffset(0),
+			nextFreeOffset(0),
+			reservedCount(0),
+			capacity(capacity),
+			elementSize(0),
+			alignment(0)
+		{}
+
+		// Release the pool allocation, all handles allocated from this pool are no longer valid
+		~NodePool()
+		{
+			if (data)
+				segmentManager->Dealloc(data);
+		}
+
+		// Segment manager instance
+		std::shared_ptr<DynamicSegment> segmentManager;
+
+		// The allocated handle for all elements
+		UINTPTR data;
+
+		// Recycled linked-list head
+		SIZE_T recycledHeadOffset;
+
+		// Next free element at the end of the allocation
+		// We use this ONLY if no recycled elements yet
+		SIZE_T nextFreeOffset;
+
+		// Count of reserved elements that are not allocated yet
+		uint32 reservedCount;
+
+		// Pool capacity
+		uint32 capacity;
+
+		// Node size & alignment the pool is allocated for, 0 before the first Init
+		uint32 elementSize;
+		uint32 alignment;
+	};
+
 	template <class T>
 	class PoolNodeAllocator
 	{
 	public:
 
 		// typedefs
-		typedef typename Pair<UINTPTR, SIZE_T> Handle;
-		typedef typename T ElementType;
+		typedef Pair<UINTPTR, SIZE_T> Handle;
+		typedef T ElementType;
 
 		// Options
 		enum { OPTION_RESIZABLE = true };
@@ -59,41 +112,25 @@ namespace Everest
 			typedef PoolNodeAllocator<T2> Other;
 		};
 
-		// Create from segment manager
+		// Create from segment manager, with a new pool
 		PoolNodeAllocator(std::shared_ptr<DynamicSegment> segment, uint32 capacity) :
-			segmentManager(segment),
-			data((UINTPTR)nullptr),
-			recycledHeadOffset(0),
-			nextFreeOffset(0),
-			capacity(capacity)
+			pool(std::make_shared<NodePool>(segment, capacity))
 		{}
 
-		// Create from other same allocator
+		// Create from other same allocator, sharing its pool
 		PoolNodeAllocator(const PoolNodeAllocator& other) : 
-			segmentManager(other.GetSegmentManager()),
-			data((UINTPTR)nullptr),
-			recycledHeadOffset(0),
-			nextFreeOffset(0),
-			capacity(other.GetCapacity())
-
+			pool(other.GetPool())
 		{}
 
-		// Create from other allocator with other type
+		// Create from other allocator with other type, sharing its pool
 		template<class T2>
 		PoolNodeAllocator(const PoolNodeAllocator<T2>& other) :
-			segmentManager(other.GetSegmentManager()),
-			data((UINTPTR)nullptr),
-			recycledHeadOffset(0),
-			nextFreeOffset(0),
-			capacity(other.GetCapacity())
+			pool(other.GetPool())
 		{}
 
-		// Destructor
+		// Destructor, the pool is released with its last allocator
 		~PoolNodeAllocator()
-		{
-			// Deallocate allocator pool
-			segmentManager->Dealloc(data);
-		}
+		{}
 
 		// Delete = operator
 		template<class T2>
@@ -106,23 +143,43 @@ namespace Everest
 			// LOG CHECK(ELEMENT_SIZE >= sizeof(UINTPTR)
 			//...
 
-			// Allocate capacity
-			data = segmentManager->Alloc(ELEMENT_SIZE * capacity, alignof(T));
-
-			// Set next free element to the first element in the allocation
-			//nextFreeOffset = (UINTPTR)SegmentManager::PointerOf(data);
+			if (pool->elementSize == 0) // Allocate capacity
+			{
+				pool->elementSize = ELEMENT_SIZE;
+				pool->alignment = alignof(T);
+				pool->data = pool->segmentManager->Alloc((SIZE_T)ELEMENT_SIZE * pool->capacity, alignof(T));
+			}
+			else if (pool->elementSize != ELEMENT_SIZE || pool->alignment != alignof(T))
+			{
+				// LOG: The pool holds nodes of another type, use an own pool
+				pool = std::make_shared<NodePool>(pool->segmentManager, pool->capacity);
+				Init();
+			}
 		}
 
 		// Get Segment manager used by this allocator
 		std::shared_ptr<DynamicSegment> GetSegmentManager() const
 		{
-			return segmentManager;
+			return pool->segmentManager;
+		}
+
+		// Get the pool shared by copies of this allocator
+		std::shared_ptr<NodePool> GetPool() const
+		{
+			return pool;
+		}
+
+		// Check if handles allocated by other can be deallocated by this allocator,
+		// copies of an allocator share its pool
+		_INLINE bool Shares(const PoolNodeAllocator& other) const
+		{
+			return pool == other.pool;
 		}
 
 		// Return allocator capacity
 		_INLINE uint32 GetCapacity() const
 		{
-			return capacity;
+			return pool->capacity;
 		}
 
 		// Allocate a new Element Pointer by recycling or adding new
@@ -130,22 +187,63 @@ namespace Everest
 		// @return - Pointer to the allocated Element
 		Handle Allocate()
 		{ 
-			if (recycledHeadOffset) // Read element from recycle...
+			if (pool->recycledHeadOffset && !pool->reservedCount) // Read element from recycle...
 			{
-				Handle result(data, recycledHeadOffset);
-				recycledHeadOffset = MemRead<UINTPTR>(DynamicSegment::PointerOf(data), recycledHeadOffset);
+				Handle result(pool->data, pool->recycledHeadOffset);
+				pool->recycledHeadOffset = MemRead<UINTPTR>(DynamicSegment::PointerOf(pool->data), pool->recycledHeadOffset);
 				return result;
 			}
 			else // Allocate new element...
 			{
-				// TODO: Expanding allocator if required
+				// Expand in place if full, handles hold the allocation handle so it can not move
+				if (pool->nextFreeOffset + ELEMENT_SIZE > (SIZE_T)pool->capacity * ELEMENT_SIZE)
+				{
+					if (pool->segmentManager->Expand(pool->data, ((SIZE_T)pool->capacity * 2 + 1) * ELEMENT_SIZE, alignof(T)))
+						pool->capacity = pool->capacity * 2 + 1;
+					else if (pool->segmentManager->Expand(pool->data, ((SIZE_T)pool->capacity + 1) * ELEMENT_SIZE, alignof(T)))
+						pool->capacity += 1;
+					else
+						return null_handle(); // LOG: OUT OF MEMORY, the allocation can not expand in place
+				}
+
+				if (pool->reservedCount)
+					--pool->reservedCount;
 				
-				Handle result(data, nextFreeOffset);
-				nextFreeOffset += ELEMENT_SIZE;
+				Handle result(pool->data, pool->nextFreeOffset);
+				pool->nextFreeOffset += ELEMENT_SIZE;
 				return result;
 			}
 		}
 
+		// Reserve count of contiguous elements at the end of the allocation,
+		// the next count calls to Allocate return them in order, skipping recycled elements.
+		// Handles hold the allocation handle, so the allocation is expanded in place if required,
+		// it is moved only while no element is allocated yet
+		//
+		// @param: count - Count of elements to reserve, less are reserved if the allocation can not expand
+		void Reserve(uint32 count)
+		{
+			SIZE_T required = pool->nextFreeOffset + (SIZE_T)count * ELEMENT_SIZE;
+			if (required > (SIZE_T)pool->capacity * ELEMENT_SIZE)
+			{
+				if (pool->segmentManager->Expand(pool->data, required, alignof(T)))
+					pool->capacity = (uint32)(required / ELEMENT_SIZE);
+				else if (pool->nextFreeOffset == 0)
+				{
+					UINTPTR handle = pool->segmentManager->Realloc(pool->data, required, alignof(T));
+					if (!handle)
+						return; // LOG: OUT OF MEMORY
+
+					pool->data = handle;
+					pool->capacity = (uint32)(required / ELEMENT_SIZE);
+				}
+				else // LOG: Allocation can not expand in place, reserve the free elements only
+					count = (uint32)(((SIZE_T)pool->capacity * ELEMENT_SIZE - pool->nextFreeOffset) / ELEMENT_SIZE);
+			}
+
+			pool->reservedCount = count;
+		}
+
 		// Allocate and construct, a new node
 		//
 		// @param: args... - The constructor arguments
@@ -153,7 +251,10 @@ namespace Everest
 		template<class ...Args>
 		Handle Allocate(Args && ...args)
 		{
-			UINTPTR handle = Allocate();
+			Handle handle = Allocate();
+			if (Parser::IsNull(handle))
+				return handle; // LOG: OUT OF MEMORY
+
 			new(Parse(handle)) T(_EVEREST Forward<Args>(args)...);
 			return handle;
 		}
@@ -163,9 +264,9 @@ namespace Everest
 		//@param: Pointer to element to deallocate & recycle
 		void Deallocate(Handle handle)
 		{
-			UINTPTR next = (recycledHeadOffset ? recycledHeadOffset : (UINTPTR)nullptr);
-			MemWrite(next, DynamicSegment::PointerOf(data), handle._second);
-			recycledHeadOffset = handle._second;
+			UINTPTR next = (pool->recycledHeadOffset ? pool->recycledHeadOffset : (UINTPTR)nullptr);
+			MemWrite(next, DynamicSegment::PointerOf(pool->data), handle._second);
+			pool->recycledHeadOffset = handle._second;
 		}
 
 		// Parse a handle and return it's pointer
@@ -185,7 +286,7 @@ namespace Everest
 
 		struct Parser
 		{
-			typedef typename Handle Handle;
+			typedef Pair<UINTPTR, SIZE_T> Handle;
 
 			// Parse a handle and return it's pointer
 			// The handle must be previously allocated using this allocator type
@@ -206,21 +307,8 @@ namespace Everest
 
 	private:
 
-		// Segment manager instance
-		std::shared_ptr<DynamicSegment> segmentManager;
-
-		// The allocated handle for all elements
-		UINTPTR data;
-
-		// Recycled linked-list head
-		SIZE_T recycledHeadOffset;
-
-		// Next free element at the end of the allocation
-		// We use this ONLY if no recycled elements yet
-		SIZE_T nextFreeOffset;
-
-		// Allocator capacity
-		uint32 capacity;
+		// Nodes pool, shared by copies of this allocator
+		std::shared_ptr<NodePool> pool;
 
 	};
 }
\ No newline at end of file
@@ -0,0 +1,169 @@
+/*****************************************************************************
+The MIT License(MIT)
+
+Copyright(c) 2016 Amr Esam
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*********************************************************************************/
+
+// Memory kernels body shared by all instruction sets,
+// this file is included by SimdMemoryOps.cpp once per instruction set inside its namespace,
+// after defining for the instruction set:
+//  - Vector type & VECTOR_SIZE in bytes
+//  - Load, Store: unaligned load & store
+//  - StoreAligned, Stream: aligned store & non-temporal store, StreamFence after streaming
+//  - Set1: vector of one byte value
+//  - DiffMask: bit mask of bytes not equal in two vectors
+
+// Copy non overlapping memory
+// The first & the last vectors are stored unaligned, all the others are aligned to destination
+static void* Copy(void* dst, const void* src, SIZE_T size)
+{
+	if (size < 2 * VECTOR_SIZE)
+		return memcpy(dst, src, size);
+
+	ubyte* d = (ubyte*)dst;
+	const ubyte* s = (const ubyte*)src;
+	const SIZE_T end = size - VECTOR_SIZE;
+
+	Vector head = Load(s);
+	Vector tail = Load(s + end);
+
+	SIZE_T i = VECTOR_SIZE - ((UINTPTR)d & (VECTOR_SIZE - 1));
+	if (size >= streamThreshold)
+	{
+		// Bigger than the cache, skip the cache
+		for (; i <= end; i += VECTOR_SIZE)
+			Stream(d + i, Load(s + i));
+		StreamFence();
+	}
+	else
+	{
+		for (; i + 4 * VECTOR_SIZE <= size; i += 4 * VECTOR_SIZE)
+		{
+			Vector v0 = Load(s + i);
+			Vector v1 = Load(s + i + VECTOR_SIZE);
+			Vector v2 = Load(s + i + 2 * VECTOR_SIZE);
+			Vector v3 = Load(s + i + 3 * VECTOR_SIZE);
+			StoreAligned(d + i, v0);
+			StoreAligned(d + i + VECTOR_SIZE, v1);
+			StoreAligned(d + i + 2 * VECTOR_SIZE, v2);
+			StoreAligned(d + i + 3 * VECTOR_SIZE, v3);
+		}
+
+		for (; i <= end; i += VECTOR_SIZE)
+			StoreAligned(d + i, Load(s + i));
+	}
+
+	Store(d, head);
+	Store(d + end, tail);
+	return dst;
+}
+
+// Copy memory that may overlap
+// Every vector is loaded before it's stored, forward when destination is before source, backward otherwise
+static void* Move(void* dst, const void* src, SIZE_T size)
+{
+	ubyte* d = (ubyte*)dst;
+	const ubyte* s = (const ubyte*)src;
+
+	if ((UINTPTR)d + size <= (UINTPTR)s || (UINTPTR)s + size <= (UINTPTR)d)
+		return Copy(dst, src, size);
+
+	if (size < 2 * VECTOR_SIZE || d == s)
+		return memmove(dst, src, size);
+
+	const SIZE_T end = size - VECTOR_SIZE;
+
+	Vector head = Load(s);
+	Vector tail = Load(s + end);
+
+	if (d < s)
+	{
+		for (SIZE_T i = VECTOR_SIZE - ((UINTPTR)d & (VECTOR_SIZE - 1)); i <= end; i += VECTOR_SIZE)
+			StoreAligned(d + i, Load(s + i));
+	}
+	else
+	{
+		for (SIZE_T i = (((UINTPTR)d + size) & ~(UINTPTR)(VECTOR_SIZE - 1)) - (UINTPTR)d; i > VECTOR_SIZE; i -= VECTOR_SIZE)
+			StoreAligned(d + i - VECTOR_SIZE, Load(s + i - VECTOR_SIZE));
+	}
+
+	Store(d, head);
+	Store(d + end, tail);
+	return dst;
+}
+
+// Set memory bytes to value
+static void* Fill(void* dst, int32 value, SIZE_T size)
+{
+	if (size < 2 * VECTOR_SIZE)
+		return memset(dst, value, size);
+
+	ubyte* d = (ubyte*)dst;
+	const SIZE_T end = size - VECTOR_SIZE;
+	Vector v = Set1((char)value);
+
+	SIZE_T i = VECTOR_SIZE - ((UINTPTR)d & (VECTOR_SIZE - 1));
+	if (size >= streamThreshold)
+	{
+		for (; i <= end; i += VECTOR_SIZE)
+			Stream(d + i, v);
+		StreamFence();
+	}
+	else
+	{
+		for (; i <= end; i += VECTOR_SIZE)
+			StoreAligned(d + i, v);
+	}
+
+	Store(d, v);
+	Store(d + end, v);
+	return dst;
+}
+
+// Compare memory bytes, returns just like memcmp
+// The last vector overlaps the one before it, when size is not a multiple of VECTOR_SIZE
+static int32 Compare(const void* p1, const void* p2, SIZE_T size)
+{
+	if (size < VECTOR_SIZE)
+		return memcmp(p1, p2, size);
+
+	const ubyte* a = (const ubyte*)p1;
+	const ubyte* b = (const ubyte*)p2;
+
+	SIZE_T i = 0;
+	for (;;)
+	{
+		if (i + VECTOR_SIZE > size)
+			i = size - VECTOR_SIZE;
+
+		uint64 mask = DiffMask(Load(a + i), Load(b + i));
+		if (mask)
+		{
+			SIZE_T index = i + CountTrailingZeros(mask);
+			return (int32)a[index] - (int32)b[index];
+		}
+
+		i += VECTOR_SIZE;
+		if (i >= size)
+			return 0;
+	}
+}
@@ -0,0 +1,376 @@
+/*****************************************************************************
+The MIT License(MIT)
+
+Copyright(c) 2016 Amr Esam
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*********************************************************************************/
+#include "SimdMemoryOps.h"
+
+#include <cstring>
+
+#ifdef SIMD_MEMORY_X86
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#include <immintrin.h>
+#endif
+
+using namespace Everest;
+
+
+/*****************
+ *	CRT KERNELS
+ *****************/
+
+namespace Everest
+{
+	// Copies & fills bigger than this use non-temporal stores
+	static SIZE_T streamThreshold = SimdMemory::DEFAULT_STREAM_THRESHOLD;
+
+	static void* CrtCopy(void* dst, const void* src, SIZE_T size)
+	{
+		return memcpy(dst, src, size);
+	}
+
+	static void* CrtMove(void* dst, const void* src, SIZE_T size)
+	{
+		return memmove(dst, src, size);
+	}
+
+	static void* CrtFill(void* dst, int32 value, SIZE_T size)
+	{
+		return memset(dst, value, size);
+	}
+
+	static int32 CrtCompare(const void* p1, const void* p2, SIZE_T size)
+	{
+		return memcmp(p1, p2, size);
+	}
+}
+
+SimdMemory::CopyFunc SimdMemory::copy = &CrtCopy;
+
+SimdMemory::CopyFunc SimdMemory::move = &CrtMove;
+
+SimdMemory::FillFunc SimdMemory::fill = &CrtFill;
+
+SimdMemory::CompareFunc SimdMemory::compare = &CrtCompare;
+
+const char* SimdMemory::instructionSet = "CRT";
+
+
+#ifdef SIMD_MEMORY_X86
+
+/*****************
+ *	CPU FEATURES
+ *****************/
+
+namespace Everest
+{
+	// Execute cpuid instruction
+	//
+	// @param: leaf - cpuid leaf (eax)
+	// @param: subleaf - cpuid subleaf (ecx)
+	// @param: regs - Output of eax, ebx, ecx & edx
+	static void Cpuid(uint32 leaf, uint32 subleaf, uint32 regs[4])
+	{
+#if defined(_MSC_VER)
+		__cpuidex((int*)regs, (int)leaf, (int)subleaf);
+#else
+		__cpuid_count(leaf, subleaf, regs[0], regs[1], regs[2], regs[3]);
+#endif
+	}
+
+	// Return the OS enabled register states (XCR0)
+	static uint64 ReadXcr0()
+	{
+#if defined(_MSC_VER)
+		return _xgetbv(0);
+#else
+		uint32 eax, edx;
+		__asm__ __volatile__("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+		return ((uint64)edx << 32) | eax;
+#endif
+	}
+
+	// Return the biggest cache size reported by deterministic cache parameters leaf (Intel: 4, AMD: 0x8000001D)
+	static SIZE_T ReadCacheSize(uint32 leaf)
+	{
+		SIZE_T result = 0;
+		uint32 regs[4];
+		for (uint32 subleaf = 0; subleaf < 16; ++subleaf)
+		{
+			Cpuid(leaf, subleaf, regs);
+			if ((regs[0] & 0x1F) == 0) // No more caches
+				break;
+
+			SIZE_T ways = (regs[1] >> 22) + 1;
+			SIZE_T partitions = ((regs[1] >> 12) & 0x3FF) + 1;
+			SIZE_T lineSize = (regs[1] & 0xFFF) + 1;
+			SIZE_T sets = (SIZE_T)regs[2] + 1;
+
+			SIZE_T size = ways * partitions * lineSize * sets;
+			if (size > result)
+				result = size;
+		}
+
+		return result;
+	}
+
+	static CpuFeatures DetectCpuFeatures()
+	{
+		CpuFeatures features = {};
+		uint32 regs[4];
+
+		Cpuid(0, 0, regs);
+		uint32 maxLeaf = regs[0];
+
+		Cpuid(0x80000000, 0, regs);
+		uint32 maxExtendedLeaf = regs[0];
+
+		if (maxLeaf < 1)
+			return features;
+
+		Cpuid(1, 0, regs);
+		features.sse2 = (regs[3] & (1 << 26)) != 0;
+
+		// AVX registers should be enabled by the OS
+		bool osxsave = (regs[2] & (1 << 27)) != 0;
+		uint64 xcr0 = osxsave ? ReadXcr0() : 0;
+		bool ymmEnabled = (xcr0 & 0x06) == 0x06;
+		bool zmmEnabled = (xcr0 & 0xE6) == 0xE6;
+
+		if (maxLeaf >= 7)
+		{
+			Cpuid(7, 0, regs);
+			features.avx2 = ymmEnabled && (regs[1] & (1 << 5)) != 0;
+			features.avx512 = zmmEnabled && (regs[1] & (1 << 16)) != 0 && (regs[1] & (1u << 30)) != 0;
+		}
+
+		// Last level cache size
+		if (maxLeaf >= 4)
+			features.lastLevelCacheSize = ReadCacheSize(4);
+
+		if (!features.lastLevelCacheSize && maxExtendedLeaf >= 0x8000001D)
+			features.lastLevelCacheSize = ReadCacheSize(0x8000001D);
+
+		return features;
+	}
+
+	// Return index of the first set bit in a non zero mask
+	_INLINE uint32 CountTrailingZeros(uint64 mask)
+	{
+#if defined(_MSC_VER)
+		unsigned long index;
+		if ((uint32)mask)
+		{
+			_BitScanForward(&index, (uint32)mask);
+			return index;
+		}
+
+		_BitScanForward(&index, (uint32)(mask >> 32));
+		return index + 32;
+#else
+		return (uint32)__builtin_ctzll(mask);
+#endif
+	}
+}
+
+
+/*****************
+ *	SSE2 KERNELS
+ *****************/
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("sse2"))), apply_to = function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("sse2")
+#endif
+
+namespace Everest
+{
+	namespace SimdSse2
+	{
+		typedef __m128i Vector;
+		enum { VECTOR_SIZE = 16 };
+
+		_INLINE Vector Load(const void* p) { return _mm_loadu_si128((const __m128i*)p); }
+		_INLINE void Store(void* p, Vector v) { _mm_storeu_si128((__m128i*)p, v); }
+		_INLINE void StoreAligned(void* p, Vector v) { _mm_store_si128((__m128i*)p, v); }
+		_INLINE void Stream(void* p, Vector v) { _mm_stream_si128((__m128i*)p, v); }
+		_INLINE void StreamFence() { _mm_sfence(); }
+		_INLINE Vector Set1(char value) { return _mm_set1_epi8(value); }
+		_INLINE uint64 DiffMask(Vector a, Vector b) { return (uint32)~_mm_movemask_epi8(_mm_cmpeq_epi8(a, b)) & 0xFFFF; }
+
+#include "SimdMemoryKernels.h"
+	}
+}
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+
+/*****************
+ *	AVX2 KERNELS
+ *****************/
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("avx2"))), apply_to = function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("avx2")
+#endif
+
+namespace Everest
+{
+	namespace SimdAvx2
+	{
+		typedef __m256i Vector;
+		enum { VECTOR_SIZE = 32 };
+
+		_INLINE Vector Load(const void* p) { return _mm256_loadu_si256((const __m256i*)p); }
+		_INLINE void Store(void* p, Vector v) { _mm256_storeu_si256((__m256i*)p, v); }
+		_INLINE void StoreAligned(void* p, Vector v) { _mm256_store_si256((__m256i*)p, v); }
+		_INLINE void Stream(void* p, Vector v) { _mm256_stream_si256((__m256i*)p, v); }
+		_INLINE void StreamFence() { _mm_sfence(); }
+		_INLINE Vector Set1(char value) { return _mm256_set1_epi8(value); }
+		_INLINE uint64 DiffMask(Vector a, Vector b) { return (uint32)~_mm256_movemask_epi8(_mm256_cmpeq_epi8(a, b)); }
+
+#include "SimdMemoryKernels.h"
+	}
+}
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+
+/*****************
+ *	AVX-512 KERNELS
+ *****************/
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("avx512f,avx512bw"))), apply_to = function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("avx512f,avx512bw")
+#endif
+
+namespace Everest
+{
+	namespace SimdAvx512
+	{
+		typedef __m512i Vector;
+		enum { VECTOR_SIZE = 64 };
+
+		_INLINE Vector Load(const void* p) { return _mm512_loadu_si512(p); }
+		_INLINE void Store(void* p, Vector v) { _mm512_storeu_si512(p, v); }
+		_INLINE void StoreAligned(void* p, Vector v) { _mm512_store_si512(p, v); }
+		_INLINE void Stream(void* p, Vector v) { _mm512_stream_si512((__m512i*)p, v); }
+		_INLINE void StreamFence() { _mm_sfence(); }
+		_INLINE Vector Set1(char value) { return _mm512_set1_epi8(value); }
+		_INLINE uint64 DiffMask(Vector a, Vector b) { return (uint64)_mm512_cmpneq_epi8_mask(a, b); }
+
+#include "SimdMemoryKernels.h"
+	}
+}
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#endif // SIMD_MEMORY_X86
+
+
+/*****************
+ *	DISPATCH
+ *****************/
+
+const CpuFeatures& CpuFeatures::Get()
+{
+#ifdef SIMD_MEMORY_X86
+	static const CpuFeatures features = DetectCpuFeatures();
+#else
+	static const CpuFeatures features = {};
+#endif
+	return features;
+}
+
+void SimdMemory::Init()
+{
+#ifdef SIMD_MEMORY_X86
+	const CpuFeatures& features = CpuFeatures::Get();
+
+	// Copies bigger than the last level cache would evict all of it
+	if (features.lastLevelCacheSize)
+		streamThreshold = features.lastLevelCacheSize;
+
+	if (features.avx512)
+	{
+		copy = &SimdAvx512::Copy;
+		move = &SimdAvx512::Move;
+		fill = &SimdAvx512::Fill;
+		compare = &SimdAvx512::Compare;
+		instructionSet = "AVX-512";
+	}
+	else if (features.avx2)
+	{
+		copy = &SimdAvx2::Copy;
+		move = &SimdAvx2::Move;
+		fill = &SimdAvx2::Fill;
+		compare = &SimdAvx2::Compare;
+		instructionSet = "AVX2";
+	}
+	else if (features.sse2)
+	{
+		copy = &SimdSse2::Copy;
+		move = &SimdSse2::Move;
+		fill = &SimdSse2::Fill;
+		compare = &SimdSse2::Compare;
+		instructionSet = "SSE2";
+	}
+#endif
+}
+
+const char* SimdMemory::GetInstructionSet()
+{
+	return instructionSet;
+}
+
+SIZE_T SimdMemory::GetStreamThreshold()
+{
+	return streamThreshold;
+}
+
+void SimdMemory::SetStreamThreshold(SIZE_T size)
+{
+	streamThreshold = size;
+}
@@ -0,0 +1,112 @@
+/*****************************************************************************
+The MIT License(MIT)
+
+Copyright(c) 2016 Amr Esam
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*********************************************************************************/
+#pragma once
+
+#include "../system.h"
+
+// SIMD kernels are available on x86 & x64 only, other cpus use the CRT functions
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define SIMD_MEMORY_X86
+#endif
+
+namespace Everest
+{
+	// Cpu features used to select memory kernels, detected once with cpuid
+	struct CpuFeatures
+	{
+		// Instruction sets supported by the cpu & the OS
+		bool sse2;
+		bool avx2;
+		bool avx512; // AVX-512 F & BW
+
+		// Last level cache size in bytes, 0 if unknown
+		SIZE_T lastLevelCacheSize;
+
+		// Return the features of the running cpu
+		static const CpuFeatures& Get();
+	};
+
+	// Runtime dispatched memory kernels,
+	// kernels are the CRT functions until Init selects the best instruction set of the running cpu.
+	// Init is called by OSMemory::Init
+	class SimdMemory
+	{
+	public:
+
+		typedef void* (*CopyFunc)(void* dst, const void* src, SIZE_T size);
+		typedef void* (*FillFunc)(void* dst, int32 value, SIZE_T size);
+		typedef int32 (*CompareFunc)(const void* p1, const void* p2, SIZE_T size);
+
+		// Copies & fills bigger than this use non-temporal stores, when the last level cache size is unknown
+		enum { DEFAULT_STREAM_THRESHOLD = 8 * 1024 * 1024 };
+
+		// Select kernels of the best instruction set supported by the running cpu
+		static void Init();
+
+		// Copy non overlapping memory
+		_INLINE static void* Copy(void* dst, const void* src, SIZE_T size)
+		{
+			return copy(dst, src, size);
+		}
+
+		// Copy memory that may overlap
+		_INLINE static void* Move(void* dst, const void* src, SIZE_T size)
+		{
+			return move(dst, src, size);
+		}
+
+		// Set memory bytes to value
+		_INLINE static void* Fill(void* dst, int32 value, SIZE_T size)
+		{
+			return fill(dst, value, size);
+		}
+
+		// Compare memory bytes, returns just like memcmp
+		_INLINE static int32 Compare(const void* p1, const void* p2, SIZE_T size)
+		{
+			return compare(p1, p2, size);
+		}
+
+		// Return name of the selected instruction set
+		static const char* GetInstructionSet();
+
+		// Return size in bytes that copies & fills bigger than it use non-temporal stores
+		static SIZE_T GetStreamThreshold();
+
+		// Set size in bytes that copies & fills bigger than it use non-temporal stores
+		static void SetStreamThreshold(SIZE_T size);
+
+	private:
+
+		// Selected kernels
+		static CopyFunc copy;
+		static CopyFunc move;
+		static FillFunc fill;
+		static CompareFunc compare;
+
+		// Selected instruction set name
+		static const char* instructionSet;
+	};
+}
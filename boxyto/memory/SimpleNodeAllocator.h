@@ -41,8 +41,8 @@ namespace Everest
 
 		// typedefs
 
-		typedef typename UINTPTR Handle;
-		typedef typename T ElementType;
+		typedef UINTPTR Handle;
+		typedef T ElementType;
 
 		// Options
 		enum { OPTION_RESIZABLE = false};
@@ -104,6 +104,13 @@ namespace Everest
 			return segmentManager;
 		}
 
+		// Check if handles allocated by other can be deallocated by this allocator,
+		// nodes are allocated from the segment, so allocators of the same segment share them
+		_INLINE bool Shares(const SimpleNodeAllocator& other) const
+		{
+			return segmentManager == other.segmentManager;
+		}
+
 		// Allocate a new node
 		//
 		// @return: Allocator handle to node
@@ -133,6 +140,12 @@ namespace Everest
 			segmentManager->Dealloc(handle);
 		}
 
+		// Reserve count of nodes for the next Allocate calls
+		void Reserve(uint32)
+		{
+			/* Every node is a separate segment allocation, nothing to reserve */
+		}
+
 		// Parse a handle and return it's pointer
 		// The handle must be previously allocated using this allocator type
 		//
@@ -149,7 +162,7 @@ namespace Everest
 		struct Parser
 		{
 
-			typedef typename Handle Handle;
+			typedef UINTPTR Handle;
 
 			// Parse a handle and return it's pointer
 			// The handle must be previously allocated using this allocator type
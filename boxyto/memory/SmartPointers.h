@@ -26,13 +26,62 @@
 #pragma once
 
 #include "../system.h"
+#include "MemoryOps.h"
+#include "StaticSegment.h"
+#include "DynamicSegment.h"
+
+#include <atomic>
 
 namespace Everest
 {
+	// Segments raw memory access, used by smart pointers to allocate their objects from boxyto memory
+	// Each segment type specialize this to provide Alloc & Free on raw pointers
+	template < class Segment >
+	struct SegmentTraits;
+
+	// StaticSegment raw memory access
+	template <>
+	struct SegmentTraits<StaticSegment>
+	{
+		_INLINE static void* Alloc(StaticSegment& segment, SIZE_T size, uint32 alignment)
+		{
+			return segment.Alloc(size, alignment);
+		}
+
+		// Static segments have no Dealloc, memory is released with the segment
+		_INLINE static void Free(StaticSegment&, void*)
+		{}
+	};
+
+	// DynamicSegment raw memory access
+	// IMPORTANT: Pointers are not updated by defragmentation
+	template <>
+	struct SegmentTraits<DynamicSegment>
+	{
+		_INLINE static void* Alloc(DynamicSegment& segment, SIZE_T size, uint32 alignment)
+		{
+			UINTPTR handle = segment.Alloc(size, alignment);
+			if (!handle)
+				return nullptr; // LOG: OUT OF MEMORY
+
+			return DynamicSegment::PointerOf(handle);
+		}
+
+		_INLINE static void Free(DynamicSegment& segment, void* ptr)
+		{
+			segment.Dealloc(ptr);
+		}
+	};
+
 	template < class T >
 	class SmartPointerBase
 	{
 	public:
+		// Construct from a pointer
+		SmartPointerBase(T* p = nullptr) :
+			_pointer(p)
+		{}
+
 		// Operator for equality check with other pointer,
 		// two pointers are equal if thier IDs & _Pointers are equal
 		_INLINE const bool operator== (const SmartPointerBase& _other) const
@@ -83,7 +132,60 @@ namespace Everest
 		T* _pointer;
 	};
 
+	// Default UniquePointer deleter, for objects allocated with new
 	template < class T >
+	struct DefaultDeleter
+	{
+		_INLINE void operator()(T* p) const
+		{
+			delete p;
+		}
+	};
+
+	// UniquePointer deleter for objects allocated by MakeUnique from a segment,
+	// the owning segment is stored before the object, so the deleter stays stateless
+	template < class Segment >
+	struct SegmentDeleter
+	{
+		// Size of the header stored before an object of type T
+		template < class T >
+		_INLINE static SIZE_T HeaderSize()
+		{
+			return (sizeof(Segment*) + alignof(T) - 1) & ~(SIZE_T)(alignof(T) - 1);
+		}
+
+		template < class T >
+		_INLINE void operator()(T* p) const
+		{
+			Destroy(p);
+
+			void* memory = (void*)Offset(p, -(SSIZE_T)HeaderSize<T>());
+			SegmentTraits<Segment>::Free(*MemRead<Segment*>(memory, 0), memory);
+		}
+	};
+
+	// StaticSegment deleter, only destructs as static segments have no Dealloc
+	template <>
+	struct SegmentDeleter<StaticSegment>
+	{
+		template < class T >
+		_INLINE static SIZE_T HeaderSize()
+		{
+			return 0;
+		}
+
+		template < class T >
+		_INLINE void operator()(T* p) const
+		{
+			Destroy(p);
+		}
+	};
+
+	// Unique pointer class, owns an object and deletes it when goes out of scope
+	//
+	// @param: Deleter - Stateless deleter type, DefaultDeleter<T> (default) or SegmentDeleter<Segment>,
+	// deleters are not stored so the pointer is one word wide
+	template < class T, class Deleter = DefaultDeleter<T> >
 	class UniquePointer :
 		public SmartPointerBase < T >
 	{
@@ -94,7 +196,7 @@ namespace Everest
 	public:
 
 		// Typedefs
-		typedef UniquePointer < T > _Myt;
+		typedef UniquePointer < T, Deleter > _Myt;
 		typedef SmartPointerBase<T> _Base;
 		typedef T ElementType;
 		typedef ElementType* pointer;
@@ -121,17 +223,416 @@ namespace Everest
 		// Delete the pointer as UniquePointer went out of scope
 		~UniquePointer()
 		{
-			if (Get())
+			Reset();
+		}
+
+		// Equal operator, move ownership to this from other
+		_INLINE _Myt& operator= (_Myt&& other)
+		{
+			if (this != &other)
+				Reset(other.Release());
+
+			return (*this);
+		}
+
+		// Release ownership of the pointer without deleting it
+		//
+		// @return: The released pointer
+		_INLINE pointer Release()
+		{
+			pointer p = this->_pointer;
+			this->_pointer = nullptr;
+			return p;
+		}
+
+		// Delete the owned pointer and take ownership of another
+		//
+		// @param: p(nullptr) - The new pointer to own
+		_INLINE void Reset(pointer p = nullptr)
+		{
+			pointer old = this->_pointer;
+			this->_pointer = p;
+			if (old)
+				Deleter()(old);
+		}
+
+	}; // UniquePointer
+
+	// Create a unique object from a segment, the object memory is freed to the segment when deleted
+	//
+	// @param: segment - The segment to allocate from, StaticSegment or DynamicSegment
+	// @param: args - The object constructor arguments
+	// @return: Unique pointer to the object, null if segment is out of memory
+	template < class T, class Segment, class ... Args >
+	UniquePointer<T, SegmentDeleter<Segment>> MakeUnique(Segment& segment, Args&& ... args)
+	{
+		// Object is placed after the header stores the owning segment
+		const SIZE_T header = SegmentDeleter<Segment>::template HeaderSize<T>();
+		const uint32 alignment = alignof(T) > alignof(Segment*) ? alignof(T) : alignof(Segment*);
+
+		void* memory = SegmentTraits<Segment>::Alloc(segment, header + sizeof(T), alignment);
+		if (!memory)
+			return UniquePointer<T, SegmentDeleter<Segment>>(); // LOG: OUT OF MEMORY
+
+		if (header)
+			MemWrite(&segment, memory, 0);
+
+		T* object = Offset(static_cast<T*>(memory), header);
+		Construct(object, _EVEREST Forward<Args>(args)...);
+
+		return UniquePointer<T, SegmentDeleter<Segment>>(object);
+	}
+
+	// Reference count policy for objects never shared across threads,
+	// plain increments with no synchronization cost
+	class RefCountNonAtomic
+	{
+	public:
+		RefCountNonAtomic() : _count(0)
+		{}
+
+		_INLINE uint32 IncRef()
+		{
+			return ++_count;
+		}
+
+		_INLINE uint32 DecRef()
+		{
+			return --_count;
+		}
+
+		_INLINE uint32 Count() const
+		{
+			return _count;
+		}
+
+	private:
+		uint32 _count;
+	};
+
+	// Reference count policy for objects shared across threads (default)
+	class RefCountAtomic
+	{
+	public:
+		RefCountAtomic() : _count(0)
+		{}
+
+		_INLINE uint32 IncRef()
+		{
+			return _count.fetch_add(1, std::memory_order_relaxed) + 1;
+		}
+
+		// When it returns 0 the caller is the last reference
+		_INLINE uint32 DecRef()
+		{
+			return _count.fetch_sub(1, std::memory_order_acq_rel) - 1;
+		}
+
+		_INLINE uint32 Count() const
+		{
+			return _count.load(std::memory_order_relaxed);
+		}
+
+	private:
+		std::atomic<uint32> _count;
+	};
+
+	// Biased reference count policy, for objects mostly used by the thread created them,
+	// the owner thread uses a non-atomic count, and other threads use an atomic shared count.
+	//
+	// When the owner count reaches 0, the owner merges: the shared count becomes the total count,
+	// and all threads use it from then on.
+	// When other threads release owner references, the shared count goes negative,
+	// then the object is queued to its owner, and merged when the owner calls MergeQueued.
+	// Owner queues outlive their threads, a finishing thread merges its queue,
+	// and objects released after their owner finished are merged by the releasing thread.
+	// IMPORTANT: Threads create biased objects should call MergeQueued at safe points (i.e once per frame),
+	// otherwise objects released by other threads are destroyed only when the owner finishes
+	class RefCountBiased
+	{
+	public:
+		RefCountBiased() : 
+			_owner(AcquireOwner()), _local(0), _merged(false), _shared(0), _nextQueued(nullptr)
+		{}
+
+		_INLINE uint32 IncRef()
+		{
+			if (_owner == CurrentOwner() && !_merged)
+				return ++_local;
+
+			return (uint32)((_shared.fetch_add(COUNT_ONE, std::memory_order_relaxed) + COUNT_ONE) >> COUNT_SHIFT);
+		}
+
+		// When it returns 0 the caller is the last reference
+		_INLINE uint32 DecRef()
+		{
+			if (_owner == CurrentOwner() && !_merged)
 			{
-				Get()->~ElementType();
-				_DELETE(Get());
+				if (--_local)
+					return _local;
+
+				// Merge, the shared count is now the total count
+				_merged = true;
+				int32 shared = _shared.fetch_or(FLAG_MERGED, std::memory_order_acq_rel);
+
+				// Queued objects are destroyed by MergeQueued
+				return (shared >> COUNT_SHIFT) == 0 && !(shared & FLAG_QUEUED) ? 0 : 1;
 			}
+
+			int32 shared = _shared.load(std::memory_order_relaxed);
+			int32 result;
+			do
+			{
+				result = shared - COUNT_ONE;
+
+				// Count is negative before the owner merged, queue to the owner
+				if ((result >> COUNT_SHIFT) < 0 && !(result & (FLAG_MERGED | FLAG_QUEUED)))
+					result |= FLAG_QUEUED;
+
+			} while (!_shared.compare_exchange_weak(shared, result, std::memory_order_acq_rel));
+
+			if ((result & FLAG_QUEUED) && !(shared & FLAG_QUEUED))
+			{
+				Enqueue();
+				return 1;
+			}
+
+			return (result >> COUNT_SHIFT) == 0 && (result & FLAG_MERGED) && !(result & FLAG_QUEUED) ? 0 : 1;
 		}
 
-	}; // UniquePointer
+		// Return the current references count,
+		// only the owner thread can read the full count, other threads read the shared count only
+		_INLINE uint32 Count() const
+		{
+			int32 shared = _shared.load(std::memory_order_relaxed) >> COUNT_SHIFT;
+			if (_owner == CurrentOwner() && !_merged)
+				shared += _local;
 
-	   // Shared pointer class, with reference monitoring support
-	template < class T >
+			return shared > 0 ? (uint32)shared : 0;
+		}
+
+		// Merge objects queued to the calling thread by other threads,
+		// and destroy the objects have no more references
+		static void MergeQueued();
+
+	private:
+
+		// Shared count is stored as (count << COUNT_SHIFT | flags)
+		enum
+		{
+			FLAG_MERGED = 1, // The owner merged its count
+			FLAG_QUEUED = 2, // Queued to the owner for merging
+			COUNT_SHIFT = 2,
+			COUNT_ONE = 1 << COUNT_SHIFT
+		};
+
+		// Owner thread queue of objects to merge, its address is the thread identity.
+		// Owners are never freed, so an address is never reused by another thread
+		struct Owner
+		{
+			// Queued objects, or CLOSED after the thread finished
+			std::atomic<RefCountBiased*> queue;
+
+			// Next owner in the registry
+			Owner* next;
+		};
+
+		// Closes the owner of the thread when the thread finishes
+		struct OwnerCloser
+		{
+			Owner* owner = nullptr;
+
+			~OwnerCloser()
+			{
+				if (owner)
+					Close(owner);
+			}
+		};
+
+		// Queue head of a finished owner thread
+		_INLINE static RefCountBiased* Closed()
+		{
+			return reinterpret_cast<RefCountBiased*>((UINTPTR)1);
+		}
+
+		// Calling thread owner slot, null before the thread creates a biased object and after it finished
+		_INLINE static Owner*& CurrentOwner()
+		{
+			static thread_local Owner* owner = nullptr;
+			return owner;
+		}
+
+		// Return the calling thread owner, created on first use
+		_INLINE static Owner* AcquireOwner()
+		{
+			Owner*& owner = CurrentOwner();
+			if (!owner)
+				owner = CreateOwner();
+
+			return owner;
+		}
+
+		// Create the calling thread owner, and add it to the registry
+		static Owner* CreateOwner()
+		{
+			// Registry keeps the owners reachable after their threads finish
+			static std::atomic<Owner*> registry(nullptr);
+
+			Owner* owner = new Owner();
+			owner->queue.store(nullptr, std::memory_order_relaxed);
+			owner->next = registry.load(std::memory_order_relaxed);
+			while (!registry.compare_exchange_weak(owner->next, owner, std::memory_order_release));
+
+			static thread_local OwnerCloser closer;
+			closer.owner = owner;
+			return owner;
+		}
+
+		// Close the owner of a finishing thread, and merge its queued objects
+		static void Close(Owner* owner);
+
+		// Merge & destroy a list of queued objects
+		static void MergeList(RefCountBiased* current);
+
+		// Push to the owner queue, or merge here if the owner finished
+		void Enqueue();
+
+		// Merge owner count into the shared count, called by the owner
+		//
+		// @return: true if no more references
+		_INLINE bool Merge()
+		{
+			int32 local = _merged ? 0 : (int32)_local;
+			_local = 0;
+			_merged = true;
+
+			int32 shared = _shared.load(std::memory_order_relaxed);
+			int32 result;
+			do
+			{
+				result = ((((shared >> COUNT_SHIFT) + local)) << COUNT_SHIFT) | FLAG_MERGED;
+			} while (!_shared.compare_exchange_weak(shared, result, std::memory_order_acq_rel));
+
+			return (result >> COUNT_SHIFT) == 0;
+		}
+
+		// The owner thread
+		Owner* const _owner;
+
+		// Owner thread count
+		uint32 _local;
+
+		// True after owner merged its count, only used by the owner
+		bool _merged;
+
+		// Other threads count with flags
+		std::atomic<int32> _shared;
+
+		// Next object in the owner queue
+		RefCountBiased* _nextQueued;
+	};
+
+	// Shared pointers control block, holds the references count,
+	// and the destroy function called when the last reference is released
+	//
+	// @param: CountPolicy - RefCountAtomic (default), RefCountNonAtomic or RefCountBiased
+	template < class CountPolicy = RefCountAtomic >
+	class RefCount :
+		public CountPolicy
+	{
+	public:
+
+		// Destructs the owned object, then releases the object & control block memory
+		typedef void(*DestroyFunc)(RefCount* refCount);
+
+		// Constructor, sets count to 0
+		//
+		// @param: destroy - Function that destroys the object and this control block
+		// @param: object - The owned object
+		// @param: owner(nullptr) - The segment owns object memory, if any
+		RefCount(DestroyFunc destroy, void* object, void* owner = nullptr) :
+			CountPolicy(), _destroy(destroy), _object(object), _owner(owner)
+		{}
+
+		// Destroy the owned object & this control block
+		_INLINE void Destroy()
+		{
+			_destroy(this);
+		}
+
+		// Return the owned object
+		_INLINE void* Object() const
+		{
+			return _object;
+		}
+
+		// Return the segment owns object memory
+		_INLINE void* Owner() const
+		{
+			return _owner;
+		}
+
+	private:
+
+		// Object destroy function
+		DestroyFunc _destroy;
+
+		// The owned object
+		void* _object;
+
+		// The segment owns object memory
+		void* _owner;
+
+	}; // RefCount
+
+	_INLINE void RefCountBiased::MergeList(RefCountBiased* current)
+	{
+		while (current)
+		{
+			RefCountBiased* next = current->_nextQueued;
+			if (current->Merge())
+				static_cast<RefCount<RefCountBiased>*>(current)->Destroy();
+
+			current = next;
+		}
+	}
+
+	_INLINE void RefCountBiased::MergeQueued()
+	{
+		Owner* owner = CurrentOwner();
+		if (owner)
+			MergeList(owner->queue.exchange(nullptr, std::memory_order_acquire));
+	}
+
+	_INLINE void RefCountBiased::Close(Owner* owner)
+	{
+		// Owner counts of this thread objects are merged by the threads release them from now on
+		CurrentOwner() = nullptr;
+		MergeList(owner->queue.exchange(Closed(), std::memory_order_acq_rel));
+	}
+
+	_INLINE void RefCountBiased::Enqueue()
+	{
+		RefCountBiased* head = _owner->queue.load(std::memory_order_acquire);
+		do
+		{
+			if (head == Closed())
+			{
+				// The owner finished, its count is not changed anymore
+				if (Merge())
+					static_cast<RefCount<RefCountBiased>*>(this)->Destroy();
+				return;
+			}
+
+			_nextQueued = head;
+		} while (!_owner->queue.compare_exchange_weak(head, this, std::memory_order_release, std::memory_order_acquire));
+	}
+
+	// Shared pointer class, with reference monitoring support
+	//
+	// @param: CountPolicy - How references are counted, RefCountAtomic (default) is safe to share across threads,
+	// RefCountNonAtomic is for single thread objects, RefCountBiased is cheap on the thread created the object
+	template < class T, class CountPolicy = RefCountAtomic >
 	class SharedPointer :
 		public SmartPointerBase < T >
 	{
@@ -139,11 +640,20 @@ namespace Everest
 		// friend pointer base class
 		friend class SmartPointerBase<T>;
 
+		// friend shared pointers of other types, for converting
+		template < class _OtherT, class _OtherPolicy >
+		friend class SharedPointer;
+
+		// friend single allocation factory
+		template < class _Type, class _Policy, class Segment, class ... Args >
+		friend SharedPointer<_Type, _Policy> MakeShared(Segment& segment, Args&& ... args);
+
 	public:
 
 		// Typedefs
-		typedef SharedPointer < T > _Myt;
+		typedef SharedPointer < T, CountPolicy > _Myt;
 		typedef SmartPointerBase<T> _Base;
+		typedef RefCount<CountPolicy> _RefCount;
 		typedef T ElementType;
 		typedef ElementType* pointer;
 
@@ -152,115 +662,174 @@ namespace Everest
 			_Base(), _refCount(nullptr)
 		{}
 
-		// Construct and initialize new shared pointer
-		SharedPointer(pointer p) :
-			_Base(p)
+		// Construct and initialize new shared pointer,
+		// the pointer should be allocated with new
+		explicit SharedPointer(pointer p) :
+			_Base(p), _refCount(nullptr)
 		{
-			_refCount = new RefCount;
-			_refCount->IncRef();
+			if (p)
+			{
+				_refCount = new _RefCount(&DeleteObject, p);
+				_refCount->IncRef();
+			}
 		}
 
 		// Construct by incementing ref count 
 		template <typename _OtherT>
-		SharedPointer(SharedPointer<_OtherT>& _other) : _Base(_other.Get())
+		SharedPointer(const SharedPointer<_OtherT, CountPolicy>& _other) : 
+			_Base(_other._pointer), _refCount(_other._refCount)
 		{
-			_refCount = _other._refCount;
-			_refCount->IncRef();
+			if (_refCount)
+				_refCount->IncRef();
 		}
 
 		// Construct by incementing ref count
-		SharedPointer(_Myt& _other)
-			: _Base(_other.Get())
+		SharedPointer(const _Myt& _other) : 
+			_Base(_other._pointer), _refCount(_other._refCount)
 		{
-			_refCount = _other._refCount;
-			_refCount->IncRef();
+			if (_refCount)
+				_refCount->IncRef();
+		}
+
+		// Construct by moving reference from other
+		SharedPointer(_Myt&& _other) :
+			_Base(_other._pointer), _refCount(_other._refCount)
+		{
+			_other._pointer = nullptr;
+			_other._refCount = nullptr;
 		}
 
 		// Destruct when no reference
 		~SharedPointer()
 		{
-			if (_refCount->DecRef() == 0)
-				Reset();
+			Reset();
 		}
 
-		// Equal operator, move ownership to this from other
-		_INLINE _Myt& operator= (_Myt& _other)
+		// Equal operator, share ownership with other
+		_INLINE _Myt& operator= (const _Myt& _other)
 		{
-			if (this != &_other)
+			if (_refCount != _other._refCount)
 			{
-				if (_refCount.DecRef() == 0)
-					Reset();
+				if (_other._refCount)
+					_other._refCount->IncRef();
 
-				Get() = _other.Get();
+				Reset();
+
+				this->_pointer = _other._pointer;
 				_refCount = _other._refCount;
 			}
 
 			return (*this);
 		}
 
-		// Equal operator, move ownership to this from other
-		template<typename Other_T>
-		_INLINE SharedPointer<Other_T>
-			operator= (const SharedPointer<Other_T>& _other)
+		// Equal operator, share ownership with other
+		template<typename _OtherT>
+		_INLINE _Myt& operator= (const SharedPointer<_OtherT, CountPolicy>& _other)
 		{
-			if (this != &_other)
+			if (_refCount != _other._refCount)
 			{
-				if (_refCount->DecRef() == 0)
-					Reset();
+				if (_other._refCount)
+					_other._refCount->IncRef();
 
-				Get() = _other.Get();
+				Reset();
+
+				this->_pointer = _other._pointer;
 				_refCount = _other._refCount;
 			}
 
 			return (*this);
 		}
 
-	private:
-
-		// Class used to handle shadred pointer reference count
-		class RefCount
+		// Equal operator, move reference from other
+		_INLINE _Myt& operator= (_Myt&& _other)
 		{
-		public:
-
-			// Constructor, sets count to 0
-			RefCount() : _count(0)
-			{}
-
-			// Increment count and return new count
-			_INLINE uint32 IncRef()
+			if (this != &_other)
 			{
-				return ++_count;
-			}
+				Reset();
 
-			// Decrement count and return new count
-			_INLINE uint32 DecRef()
-			{
-				return --_count;
+				this->_pointer = _other._pointer;
+				_refCount = _other._refCount;
+				_other._pointer = nullptr;
+				_other._refCount = nullptr;
 			}
 
-			// Return the current references count
-			_INLINE uint32 Count()
-			{
-				return _count;
-			}
+			return (*this);
+		}
 
-		private:
+		// Release this reference, the object is destroyed if this is the last reference
+		_INLINE void Reset()
+		{
+			if (_refCount && _refCount->DecRef() == 0)
+				_refCount->Destroy();
 
-			// count of pointer references
-			uint32 _count;
+			this->_pointer = nullptr;
+			_refCount = nullptr;
+		}
 
-		}; // RefCount
+		// Return count of references to the object
+		_INLINE uint32 UseCount() const
+		{
+			return _refCount ? _refCount->Count() : 0;
+		}
 
-		   // The reference count object
-		RefCount* _refCount;
+	private:
 
-		_INLINE void Reset()
+		// Construct from object and its control block, used by MakeShared
+		SharedPointer(pointer p, _RefCount* refCount) :
+			_Base(p), _refCount(refCount)
 		{
-			delete _refCount;
+			_refCount->IncRef();
+		}
 
-			// Destruct & delete
-			Get()->~ElementType();
-			_DELETE(Get());
+		// Destroy function for objects allocated with new
+		static void DeleteObject(_RefCount* refCount)
+		{
+			delete static_cast<pointer>(refCount->Object());
+			delete refCount;
 		}
+
+		// The reference count object
+		_RefCount* _refCount;
+
 	}; // SharedPointer
-}
\ No newline at end of file
+
+	// Destroy function for objects allocated by MakeShared,
+	// the object & control block are in one segment allocation starts with the control block
+	template < class T, class CountPolicy, class Segment >
+	void DestroyShared(RefCount<CountPolicy>* refCount)
+	{
+		Destroy(static_cast<T*>(refCount->Object()));
+
+		Segment* segment = static_cast<Segment*>(refCount->Owner());
+		refCount->~RefCount<CountPolicy>();
+		SegmentTraits<Segment>::Free(*segment, refCount);
+	}
+
+	// Create a shared object, the object & its control block are allocated together
+	// with one segment allocation, this saves an allocation and a cache miss per object
+	//
+	// Count policy is selected by the second template argument, i.e MakeShared<T, RefCountBiased>(segment)
+	//
+	// @param: segment - The segment to allocate from, StaticSegment or DynamicSegment
+	// @param: args - The object constructor arguments
+	// @return: Shared pointer to the object, null if segment is out of memory
+	template < class T, class CountPolicy = RefCountAtomic, class Segment, class ... Args >
+	SharedPointer<T, CountPolicy> MakeShared(Segment& segment, Args&& ... args)
+	{
+		typedef RefCount<CountPolicy> _RefCount;
+
+		// Object is placed after the control block
+		const SIZE_T offset = (sizeof(_RefCount) + alignof(T) - 1) & ~(SIZE_T)(alignof(T) - 1);
+		const uint32 alignment = alignof(T) > alignof(_RefCount) ? alignof(T) : alignof(_RefCount);
+
+		void* memory = SegmentTraits<Segment>::Alloc(segment, offset + sizeof(T), alignment);
+		if (!memory)
+			return SharedPointer<T, CountPolicy>(); // LOG: OUT OF MEMORY
+
+		T* object = Offset(static_cast<T*>(memory), offset);
+		Construct(object, _EVEREST Forward<Args>(args)...);
+
+		_RefCount* refCount = new (memory) _RefCount(&DestroyShared<T, CountPolicy, Segment>, object, &segment);
+		return SharedPointer<T, CountPolicy>(object, refCount);
+	}
+}
@@ -123,6 +123,26 @@ namespace Everest
 			return AlignW(result, alignment);
 		}
 
+		// Return a mark of the current allocations, allocations made after the mark are freed by Rewind
+		//
+		// @return: The mark, allocated size in bytes
+		_INLINE SIZE_T Mark() const
+		{
+			return allocationSize;
+		}
+
+		// Free all allocations made after mark at once, use this for scratch memory
+		//
+		// @param: mark - A mark returned by Mark
+		void Rewind(SIZE_T mark)
+		{
+			if (mark > allocationSize)
+				return; // LOG: Invalid mark
+
+			memory = Offset(memory, -(SSIZE_T)(allocationSize - mark));
+			allocationSize = mark;
+		}
+
 		// Return an allocation size allocated by a StaticSegment
 		//
 		// @param: ptr - pointer to get size of
@@ -25,9 +25,11 @@ SOFTWARE.
 #pragma once
 
 #include "StaticSegment.h"
+#include "DynamicSegment.h"
 #include "MemoryOps.h"
 
 #include <memory>
+#include <new>
 
 namespace Everest
 {
@@ -105,5 +107,94 @@ namespace Everest
 		std::shared_ptr<StaticSegment> segmentManager;
 
 	};
+
+	// Std allocator that consumes a DynamicSegment, deallocate releases memory back to the segment
+	// so std containers that reallocate or live long do not leak their old buffers.
+	// Allocations are accessed by raw pointers, so the segment should not be defragmented
+	// while a container uses it.
+	template <class T>
+	class DynamicStdAllocator
+	{
+	public:
+
+		// typedefs
+		typedef T value_type;
+		typedef value_type* pointer;
+		typedef const value_type* const_pointer;
+		typedef value_type& reference;
+		typedef const value_type& const_reference;
+		typedef std::size_t size_type;
+		typedef std::ptrdiff_t difference_type;
+
+		// Convert a DynamicStdAllocator<T> to DynamicStdAllocator<T2>
+		template<typename T2>
+		struct rebind {
+			typedef DynamicStdAllocator<T2> other;
+		};
+
+		inline explicit DynamicStdAllocator(std::shared_ptr<DynamicSegment> segment) :
+			segmentManager(segment)
+		{}
+		inline ~DynamicStdAllocator() {}
+		inline DynamicStdAllocator(DynamicStdAllocator const& other) :
+			segmentManager(other.GetSegmentManager())
+		{}
+		template<typename T2>
+		inline DynamicStdAllocator(DynamicStdAllocator<T2> const& other) :
+			segmentManager(other.GetSegmentManager())
+		{}
+
+		// Address
+		inline pointer address(reference ref) { return &ref; }
+		inline const_pointer address(const_reference ref) { return &ref; }
+
+		// Memory allocation
+		inline pointer allocate(size_type cnt,
+			const void* = 0) {
+			UINTPTR handle = segmentManager->Alloc((cnt * sizeof(T)), alignof(T));
+			if (!handle)
+				throw std::bad_alloc(); // LOG: OUT OF MEMORY, std containers never check for nullptr
+
+			return reinterpret_cast<pointer>(DynamicSegment::PointerOf(handle));
+		}
+		inline void deallocate(pointer p, size_type) {
+			segmentManager->Dealloc((void*)p);
+		}
+
+		// Size
+		inline size_type max_size() const {
+			return ((size_t)(-1) / sizeof(T));
+		}
+
+		// Construction/destruction, of any type so containers can emplace & construct their nodes
+		template<class U, class... Args>
+		inline void construct(U* p, Args&&... args) { _EVEREST Construct(p, _EVEREST Forward<Args>(args)...); }
+		template<class U>
+		inline void destroy(U* p) { _EVEREST Destroy(p, 1); }
+
+		// Two allocators are equal if they consume the same segment,
+		// so memory allocated by one can be deallocated by the other
+		template<typename T2>
+		inline bool operator==(DynamicStdAllocator<T2> const& other) const
+		{
+			return segmentManager == other.GetSegmentManager();
+		}
+		template<typename T2>
+		inline bool operator!=(DynamicStdAllocator<T2> const& other) const
+		{
+			return !operator==(other);
+		}
+
+		// Get Segment manager used by this allocator
+		std::shared_ptr<DynamicSegment> GetSegmentManager() const
+		{
+			return segmentManager;
+		}
+
+	private:
+
+		std::shared_ptr<DynamicSegment> segmentManager;
+
+	};
 #pragma warning( pop ) 
 }
\ No newline at end of file